@@ -0,0 +1,47 @@
+#ifndef BACKUP_STORE_HPP
+#define BACKUP_STORE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "student.hpp"
+#include "student_view.hpp"
+
+// 备份信息（manifest.txt 中的一行）
+struct BackupInfo {
+    int id = 0;
+    std::string timestamp;   // YYYY-MM-DD HH:MM:SS
+    bool full = false;       // 全量备份还是增量备份
+    size_t changed = 0;      // 新增或修改的记录数
+    size_t removed = 0;      // 删除的记录数
+    std::string file;
+};
+
+// 增量备份目录
+// 每次备份只保存自上次备份以来内容有变化的记录（+记录）和被删除的学号（-学号），
+// 变化由记录内容哈希判断（名次是派生数据，不参与比较）。哈希表 hashes.txt 记录它对应的备份号，
+// 与 manifest 最后一次备份不符时（例如两者之间崩溃）改做全量备份。每隔若干次做一次全量备份，
+// 限制恢复时需要回放的链长度
+class BackupStore {
+public:
+    static const int FULL_BACKUP_INTERVAL = 24;
+
+    explicit BackupStore(const std::string& dir);
+
+    bool create(const StudentView& students, BackupInfo& info, std::string& error);
+    std::vector<BackupInfo> list() const;
+    // 重建第 id 次备份时的完整数据
+    bool restore(int id, std::vector<Student>& students, std::string& error) const;
+
+private:
+    std::string dir;
+
+    std::string manifestPath() const;
+    std::string hashesPath() const;
+    bool loadHashes(int& backupId, std::vector<std::pair<std::string, uint64_t>>& hashes) const;
+    bool saveHashes(int backupId, const StudentView& students, const std::vector<uint64_t>& hashes) const;
+    bool applyBackupFile(const BackupInfo& info, std::vector<Student>& students,
+                         std::vector<bool>& alive, std::string& error) const;
+};
+
+#endif // BACKUP_STORE_HPP
@@ -0,0 +1,26 @@
+#ifndef BINARY_FORMAT_HPP
+#define BINARY_FORMAT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "student.hpp"
+#include "student_view.hpp"
+
+// 二进制列式数据文件
+// 布局：文件头（含快照对应的日志序号）| 7 个 double 成绩列 | age、rank 两个 int32 列 | gender 列 |
+//       5 个字符串引用列（偏移 + 长度）| 字符串堆
+// 各列按 8 字节对齐，载入时直接从映射内存中按列读取，不做逐字段文本解析
+class BinaryFormat {
+public:
+    static const uint32_t MAGIC = 0x424D5353;  // "SSMB"
+    static const uint32_t VERSION = 2;  // v2：文件头增加日志序号
+
+    static bool isBinaryFile(const std::string& path);
+    static bool save(const StudentView& students, const std::string& path, std::string& error,
+                     uint64_t sequence = 0, bool durable = false);
+    static bool load(const std::string& path, std::vector<Student>& students, std::string& error,
+                     uint64_t* sequence = nullptr);
+};
+
+#endif // BINARY_FORMAT_HPP
@@ -0,0 +1,54 @@
+#ifndef BUFFERED_WRITER_HPP
+#define BUFFERED_WRITER_HPP
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// 大缓冲区输出：调用者直接向 buffer() 追加内容，攒满后一次 fwrite
+// 开启后台写入时采用双缓冲，格式化与磁盘 I/O 重叠进行
+class BufferedWriter {
+public:
+    static const size_t DEFAULT_CAPACITY = 4 << 20;  // 4 MiB
+
+    explicit BufferedWriter(size_t capacity = DEFAULT_CAPACITY, bool background = false);
+    ~BufferedWriter();
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    bool open(const std::string& path, bool appendMode = false);
+    bool close();  // 写出剩余数据并关闭，返回整个写入过程是否成功
+    bool sync();   // 写出所有数据并 fsync 到磁盘
+
+    std::string& buffer() { return current; }
+    void append(const char* data, size_t size);
+    void append(const std::string& text) { append(text.data(), text.size()); }
+
+    // 每写完一条记录后调用，缓冲区满时提交
+    void commitIfFull() {
+        if (current.size() >= capacity) commit();
+    }
+    void commit();
+
+private:
+    std::FILE* file;
+    size_t capacity;
+    bool background;
+    bool failed;
+    std::string current;   // 正在格式化的缓冲区
+
+    // 后台写入状态
+    std::thread ioThread;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::string pending;   // 等待后台线程写出的缓冲区
+    bool hasPending;
+    bool stopping;
+
+    void writeOut(const std::string& data);
+    void ioLoop();
+};
+
+#endif // BUFFERED_WRITER_HPP
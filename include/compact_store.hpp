@@ -0,0 +1,66 @@
+#ifndef COMPACT_STORE_HPP
+#define COMPACT_STORE_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "intern_table.hpp"
+#include "student.hpp"
+#include "student_view.hpp"
+
+// 紧凑学生存储：每条记录固定 28 字节
+//   五门成绩存为两位小数定点 uint16（0.00 ~ 655.35），性别与年龄合成 1 字节，
+//   院系、专业、班级存驻留编号，学号和姓名拼接进同一块字符区，只存偏移和长度；
+//   总分、平均分取出时重新计算，名次不保存
+// 无法无损压缩的记录（非两位小数的成绩、年龄超过 127、超长字符串等）原样放入旁路表
+// 对外仍以 Student 值类型读写
+// 目前仅供容量规划：内存报告用 estimate() 估算名册改用紧凑存储后的占用，并不作为任何数据的实际存储
+class CompactStudentStore {
+public:
+    // 占用估算：不构建存储，按每条记录的大小累计；驻留表直接计入调用方已有的表
+    // （名册的院系、专业、班级驻留表与紧凑存储所需的相同）
+    struct Estimate {
+        size_t bytes = 0;
+        size_t exceptions = 0;  // 无法无损压缩、需放入旁路表的记录数
+    };
+    static Estimate estimate(const StudentView& students, const InternTable& departments,
+                             const InternTable& majors, const InternTable& classes);
+
+    void clear();
+    void reserve(size_t count, size_t textBytes = 0);
+    void push(const Student& student);
+    Student get(size_t index) const;  // rank 为 0
+    size_t size() const { return records.size(); }
+
+    size_t exceptionCount() const { return exceptions.size(); }
+    size_t memoryUsage() const;  // 含记录数组、字符区、驻留表和旁路表
+
+private:
+    struct Record {
+        uint32_t idOffset;
+        uint32_t nameOffset;
+        uint8_t idLength;
+        uint8_t nameLength;
+        uint8_t genderAge;     // 最高位：1 = 男；低 7 位：年龄
+        uint8_t flags;         // EXCEPTION：完整记录在旁路表中
+        uint16_t scores[5];    // 成绩 * 100
+        uint16_t department;
+        uint16_t major;
+        uint16_t className;
+    };
+    static const uint8_t EXCEPTION = 1;
+
+    std::vector<Record> records;
+    std::string text;  // 学号、姓名字符区
+    InternTable departments;
+    InternTable majors;
+    InternTable classes;
+    std::unordered_map<uint32_t, Student> exceptions;
+
+    static bool packScore(double score, uint16_t& packed);
+    static bool fitsRecord(const Student& student);  // 单条记录本身能否无损压缩
+    bool fits(const Student& student) const;         // 另含字符区与驻留编号的容量限制
+};
+
+#endif // COMPACT_STORE_HPP
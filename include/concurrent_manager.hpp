@@ -0,0 +1,145 @@
+#ifndef CONCURRENT_MANAGER_HPP
+#define CONCURRENT_MANAGER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "student.hpp"
+#include "rank_index.hpp"
+
+class Journal;
+class Query;
+class StudentBatch;
+struct BatchResult;
+
+// 不可变的版本化快照：持有 shared_ptr 期间，其中的记录及取得的引用、指针一直有效
+// 记录按 CHUNK_SIZE 分块、学号索引按 ID_SHARDS 分片存放，院系、专业、班级各有一份
+// 取值 -> 下标列表的索引，下标列表按 POSTING_BLOCK 分块；排名为共享的基础索引加一份小的增量。
+// 新版本只复制被修改的块、分片、下标列表块和增量，其余部分与旧版本共享
+// 注意：记录中的 rank 字段不随其他记录的变化而更新，名次请用 rankOf()
+class StudentSnapshot {
+public:
+    static const size_t CHUNK_SIZE = 256;
+    static const size_t ID_SHARDS = 64;
+    static const size_t POSTING_BLOCK = 256;
+    static const size_t RANK_DELTA_LIMIT = 256;
+
+    uint64_t version() const { return snapshotVersion; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    const Student& operator[](size_t index) const {
+        return (*chunks[index / CHUNK_SIZE])[index % CHUNK_SIZE];
+    }
+    const Student* find(const std::string& id) const;
+    int rankOf(const Student& student) const;
+
+    // 按存储顺序逐条访问 fn(const Student&)
+    template <typename F>
+    void forEach(F&& fn) const {
+        for (const auto& chunk : chunks) {
+            for (const Student& student : *chunk) fn(student);
+        }
+    }
+    // 顶层 AND 中的学号、院系、专业、班级等值谓词走索引，其余（含子串谓词）逐条扫描
+    std::vector<const Student*> select(const Query& query) const;
+    StudentManager::Statistics getStatistics() const;
+
+private:
+    enum Category { DEPARTMENT, MAJOR, CLASS_NAME, CATEGORY_COUNT };
+    using Chunk = std::vector<Student>;
+    using IdShard = std::unordered_map<std::string, uint32_t>;  // 学号 -> 下标
+    // 每条记录在其院系、专业、班级下标列表中的位置，与记录一样按 CHUNK_SIZE 分块
+    using Positions = std::vector<std::array<uint32_t, CATEGORY_COUNT>>;
+
+    // 一个取值的下标列表（无序），除最后一块外每块都是满的
+    struct Postings {
+        using Block = std::vector<uint32_t>;
+        size_t count = 0;
+        std::vector<std::shared_ptr<const Block>> blocks;
+
+        uint32_t operator[](size_t i) const { return (*blocks[i / POSTING_BLOCK])[i % POSTING_BLOCK]; }
+    };
+    using CategoryMap = std::unordered_map<std::string, std::shared_ptr<const Postings>>;
+
+    // 基础排名索引之后的增删：按分数升序，above 为分数更高的各项人数变化之和
+    struct RankDelta {
+        struct Entry {
+            double score;
+            int delta;
+            int above;
+        };
+        std::vector<Entry> entries;
+
+        void add(double averageScore, int delta);
+        int countAbove(double averageScore) const;
+    };
+
+    uint64_t snapshotVersion = 0;
+    size_t count = 0;
+    std::vector<std::shared_ptr<const Chunk>> chunks;
+    std::vector<std::shared_ptr<const Positions>> positions;
+    std::vector<std::shared_ptr<const IdShard>> shards;
+    std::shared_ptr<const CategoryMap> categories[CATEGORY_COUNT];
+    // 名次 = 基础索引（多个版本共享）+ 增量；增量超过 RANK_DELTA_LIMIT 项时并入新的基础索引
+    std::shared_ptr<const RankIndex> ranks;
+    std::shared_ptr<const RankDelta> rankDelta;
+
+    static size_t shardOf(const std::string& id);
+    static const std::string& categoryOf(const Student& student, int category);
+    const Postings* postings(int category, const std::string& value) const;
+
+    friend class ConcurrentStudentManager;
+};
+
+// 并发模式的学生管理：读者无锁地取得当前快照，写者串行地在副本上修改后整体发布
+//   auto snapshot = manager.snapshot();
+//   if (const Student* s = snapshot->find(id)) use(*s, snapshot->rankOf(*s));
+// 旧版本在最后一个持有者释放后回收
+// 这是 sms_core 提供给嵌入程序的接口，适合读者需要长时间持有一致视图、又不能阻塞写者的场景。
+// 本项目的命令行程序是单线程的；查询服务（query_server.hpp）仍用 StudentManager 加读写锁，
+// 因为它依赖的 selectTop、分组统计和三元组子串查询快照尚未提供，而每个请求持锁时间都很短
+class ConcurrentStudentManager {
+public:
+    ConcurrentStudentManager();
+    ~ConcurrentStudentManager();
+    ConcurrentStudentManager(const ConcurrentStudentManager&) = delete;
+    ConcurrentStudentManager& operator=(const ConcurrentStudentManager&) = delete;
+
+    // 读路径：只有原子读写，不加锁，可在任意线程并发调用
+    std::shared_ptr<const StudentSnapshot> snapshot() const;
+    uint64_t version() const;
+
+    // 写路径：互斥串行，每次调用发布一个新版本
+    Status addStudent(const Student& student);
+    Status deleteStudent(const std::string& id);
+    Status updateStudent(const std::string& id, const Student& newStudent);
+    BatchResult apply(const StudentBatch& batch, bool atomic = true);  // 整批只发布一个版本
+    // 整体替换，学号重复时保留第一条；日志中记为清空加逐条添加（只含保留下来的记录）
+    void setStudents(const std::vector<Student>& students);
+    void setJournal(Journal* newJournal);
+
+private:
+    // 发布节点：读者在纪元保护下复制其中的 shared_ptr
+    struct Published {
+        std::shared_ptr<const StudentSnapshot> snapshot;
+        uint64_t retiredEpoch = 0;
+    };
+    class Draft;
+
+    std::atomic<Published*> current;
+    std::shared_ptr<const StudentSnapshot> latest;  // 读者槽位用尽时的后备路径（std::atomic_load）
+    std::vector<Published*> retired;                // 等待所有读者离开的旧节点
+    std::mutex writeMutex;
+    Journal* journal = nullptr;
+
+    void publish(std::shared_ptr<const StudentSnapshot> next);
+    void reclaim();
+};
+
+#endif // CONCURRENT_MANAGER_HPP
@@ -0,0 +1,32 @@
+#ifndef INTERN_TABLE_HPP
+#define INTERN_TABLE_HPP
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// 字符串驻留表：每个不同的取值分配一个从 0 开始的小整数编号
+// 院系、专业、班级只有几十种取值，比较、分组都可以换成整数运算
+class InternTable {
+public:
+    static const uint32_t NONE = UINT32_MAX;
+
+    void clear();
+    uint32_t intern(std::string_view value);      // 不存在时新建
+    uint32_t find(std::string_view value) const;  // 不存在时返回 NONE
+    const std::string& name(uint32_t id) const { return names[id]; }
+    size_t size() const { return names.size(); }
+    size_t memoryUsage() const;
+
+    // 各编号按字符串排序后的序号，order[id] 越小字符串越靠前
+    std::vector<uint32_t> sortedOrder() const;
+
+private:
+    std::deque<std::string> names;  // deque 保证扩容时元素地址不变，ids 的键指向这里
+    std::unordered_map<std::string_view, uint32_t> ids;
+};
+
+#endif // INTERN_TABLE_HPP
@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 #include "student.hpp"
+#include "student_view.hpp"
+#include "storage.hpp"
 
 // 输入辅助类
 class InputHelper {
@@ -15,29 +17,41 @@ public:
     static bool confirm(const std::string& message);
 };
 
-// 文件存储类
-class FileStorage {
+// 结果集分页器：持有结果视图和当前页，翻页不会重新执行查询
+class StudentPager {
 private:
-    std::string dataDir;      // 确保这个私有成员存在
-    std::string dataFile;
-    void ensureDataDirectory();
+    StudentView students;
+    size_t pageSize;
+    size_t page;
     
 public:
-    FileStorage();
-    void setDataFile(const std::string& path);
-    bool saveStudents(const std::vector<Student>& students);
-    std::vector<Student> loadStudents();
-    bool createBackup();
-    bool exportToCSV(const std::vector<Student>& students, const std::string& filename);
-    std::vector<Student> importFromCSV(const std::string& filename);
+    static const size_t DEFAULT_PAGE_SIZE = 20;
+    
+    explicit StudentPager(const StudentView& students, size_t pageSize = DEFAULT_PAGE_SIZE);
+    size_t pageCount() const;
+    size_t currentPage() const;  // 从 0 开始
+    bool next();
+    bool prev();
+    bool jump(size_t newPage);
+    // 只把当前页格式化进 out（追加）
+    void render(std::string& out) const;
 };
 
 // 显示辅助类
 class DisplayHelper {
 public:
+    // 非交互模式（脚本、定时任务）下不清屏、不暂停，表格一次输出全部记录
+    static void setInteractive(bool enabled);
     static void clearScreen();
-    static void displayStudentTable(const std::vector<Student>& students, bool showAll = false);
+    // showAll 为 true 且超过一页时进入交互式分页浏览
+    static void displayStudentTable(const StudentView& students, bool showAll = false);
+    static void browseStudentTable(const StudentView& students);
+    static void displayStudent(const Student& student);
+    static void displayFailingStudents(const StudentView& students);
     static void displayStatistics(const StudentManager::Statistics& stats);
+    static void displayGroupedStatistics(const std::string& title,
+                                         const std::vector<StudentManager::GroupStatistics>& groups);
+    static void displayMemoryReport(const StudentManager::MemoryReport& report);
     static void displayMenu();
     static void showWelcome();
     static void pause();
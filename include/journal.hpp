@@ -0,0 +1,63 @@
+#ifndef JOURNAL_HPP
+#define JOURNAL_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "buffered_writer.hpp"
+
+struct Student;
+class StudentManager;
+
+// 预写日志：记录通过 StudentManager 发生的增删改
+// 每条记录一行：<校验和8位十六进制> <序号>|<操作>|<内容>
+//   A|<学生文本>       添加
+//   D|<学号>           删除
+//   U|<原学号>|<学生文本> 修改
+//   C|                 清空（批量导入前）
+// 每条记录在返回前写入操作系统（进程崩溃后仍在文件中），fsync 按批次进行：
+// 攒满 batchSize 条或距上次 fsync 超过 1 秒时执行，掉电最多丢失最近一批；保存快照后截断日志
+class Journal {
+public:
+    Journal();
+    ~Journal();
+
+    bool open(const std::string& path, uint64_t baseSequence = 0);
+    void close();
+    bool isOpen() const { return opened; }
+
+    void logAdd(const Student& student);
+    void logDelete(const std::string& id);
+    void logUpdate(const std::string& oldId, const Student& student);
+    void logClear();
+
+    bool sync();                      // 立即写出并 fsync
+    bool truncate();                  // 快照落盘后清空日志
+    bool needsCompaction() const;     // 日志条数超过阈值，应当生成快照
+
+    void setBatchSize(size_t size) { batchSize = size; }
+    void setCompactThreshold(size_t count) { compactThreshold = count; }
+    uint64_t lastSequence() const { return sequence; }
+
+    // 把序号大于 afterSequence 的记录重放到 manager 上，返回重放条数
+    size_t replay(StudentManager& manager, uint64_t afterSequence);
+
+private:
+    std::string path;
+    BufferedWriter writer;
+    bool opened;
+    uint64_t sequence;        // 最后一条记录的序号
+    size_t unsynced;          // 尚未 fsync 的记录数
+    size_t recordCount;       // 自上次截断以来的记录数
+    size_t batchSize;
+    size_t compactThreshold;
+    std::chrono::steady_clock::time_point lastSync;
+    std::string line;         // 复用的记录缓冲区
+
+    void append(char op, const std::string& payload);
+    bool readRecords(std::vector<std::string>& records, std::vector<uint64_t>& sequences,
+                     size_t* validBytes = nullptr, bool quiet = false);
+};
+
+#endif // JOURNAL_HPP
@@ -0,0 +1,33 @@
+#ifndef MEMORY_USAGE_HPP
+#define MEMORY_USAGE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// 容器内存占用估算，供内存报告使用（只统计堆上部分，不含对象本身）
+namespace MemoryUsage {
+
+// 短字符串存放在对象内部（SSO）时没有堆分配
+inline size_t heapBytes(const std::string& text) {
+    const char* data = text.data();
+    const char* self = reinterpret_cast<const char*>(&text);
+    bool inline_ = data >= self && data < self + sizeof(std::string);
+    return inline_ ? 0 : text.capacity() + 1;
+}
+
+template <typename T>
+size_t heapBytes(const std::vector<T>& values) {
+    return values.capacity() * sizeof(T);
+}
+
+// 哈希表：桶数组 + 每个节点（值、next 指针、缓存的哈希值）
+template <typename Map>
+size_t hashTableBytes(const Map& map) {
+    return map.bucket_count() * sizeof(void*)
+         + map.size() * (sizeof(typename Map::value_type) + sizeof(void*) + sizeof(size_t));
+}
+
+} // namespace MemoryUsage
+
+#endif // MEMORY_USAGE_HPP
@@ -0,0 +1,102 @@
+#ifndef QUERY_HPP
+#define QUERY_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Student;
+class CompiledQuery;
+class CategoryIndex;
+
+// 组合查询：比较、区间、子串谓词，用 AND / OR / NOT 组合
+//   Query q = Query::compare(Query::Field::Major, Query::Op::Eq, "SE")
+//          && Query::compare(Query::Field::Math, Query::Op::Lt, 60)
+//          && Query::between(Query::Field::Age, 19, 21);
+// 也可以从文本解析：major = SE and math < 60 and age between 19 and 21
+class Query {
+public:
+    enum class Field {
+        Id, Name, Gender, Age, Department, Major, ClassName,
+        Math, Cpp, English, LinearAlgebra, Political, Total, Average, Rank
+    };
+    enum class Op { Eq, Ne, Lt, Le, Gt, Ge, Between, Contains };
+
+    // 单个谓词；数值字段使用 low/high，字符串字段使用 text/textHigh
+    struct Predicate {
+        Field field = Field::Id;
+        Op op = Op::Eq;
+        double low = 0;
+        double high = 0;
+        std::string text;
+        std::string textHigh;
+    };
+
+    Query();  // 空查询匹配所有记录
+
+    static Query compare(Field field, Op op, double value);
+    static Query compare(Field field, Op op, const std::string& value);
+    static Query between(Field field, double low, double high);
+    static Query contains(Field field, const std::string& text);
+
+    friend Query operator&&(const Query& a, const Query& b);
+    friend Query operator||(const Query& a, const Query& b);
+    friend Query operator!(const Query& q);
+
+    static bool parse(const std::string& text, Query& query, std::string& error);
+    static bool fieldFromName(const std::string& name, Field& field);
+    static bool isNumeric(Field field);
+
+    CompiledQuery compile() const;
+
+private:
+    struct Node {
+        enum Kind { Test, And, Or, Not } kind = Test;
+        Predicate predicate;
+        std::vector<std::shared_ptr<const Node>> children;
+    };
+    std::shared_ptr<const Node> root;
+
+    static Query combine(Node::Kind kind, const Query& a, const Query& b);
+    static void emit(const Node& node, CompiledQuery& compiled);
+    static void collectConjuncts(const Node& node, CompiledQuery& compiled);
+
+    friend class QueryParser;
+};
+
+// 编译后的查询：后缀形式的扁平谓词程序，逐条记录求值时不再比较字段名字符串
+class CompiledQuery {
+public:
+    bool matches(const Student& student) const;
+    // slot 为记录在 StudentManager 中的下标，已绑定的分类等值谓词只比较驻留编号
+    bool matches(const Student& student, uint32_t slot) const;
+    bool empty() const { return program.empty(); }
+
+    // 把 field 上的 = / != 谓词绑定到索引的驻留编号列；索引变动后需重新编译绑定
+    void bindCategory(Query::Field field, const CategoryIndex& index);
+    bool usesRank() const { return rankUsed; }
+
+    // 顶层 AND 中的各个谓词，供调用者挑选可用索引
+    const std::vector<Query::Predicate>& conjuncts() const { return topLevel; }
+
+private:
+    struct Instruction {
+        enum Kind { Test, And, Or, Not } kind;
+        Query::Predicate predicate;
+        const uint32_t* ids = nullptr;  // 绑定后：按下标的驻留编号列
+        uint32_t valueId = 0;           // 绑定后：比较值的编号
+    };
+    std::vector<Instruction> program;
+    std::vector<Query::Predicate> topLevel;
+    bool rankUsed = false;
+
+    static const uint32_t NO_SLOT = UINT32_MAX;
+
+    static bool test(const Query::Predicate& predicate, const Student& student);
+    bool run(const Student& student, uint32_t slot) const;
+
+    friend class Query;
+};
+
+#endif // QUERY_HPP
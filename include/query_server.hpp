@@ -0,0 +1,66 @@
+#ifndef QUERY_SERVER_HPP
+#define QUERY_SERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_set>
+#include "student.hpp"
+
+// 本地 HTTP/JSON 查询服务（仅 Linux，epoll）
+// 一个事件循环线程负责 accept 和就绪通知，请求在工作线程池中解析与处理；
+// 读请求持有共享锁并发执行，只调用不写入记录的只读接口（名次由修改请求在独占锁内刷新），
+// 修改请求持有独占锁。支持 HTTP/1.1 keep-alive。
+// 不使用 ConcurrentStudentManager 的原因见 concurrent_manager.hpp
+//   GET    /students/<id>                       按学号查找
+//   GET    /search?field=<f>&value=<v>          条件查询（同菜单中的字段）
+//   GET    /search?q=<表达式>                   组合查询，见 query.hpp
+//   GET    /stats[?group=department|major|class]
+//   GET    /top?k=<k>[&column=average][&order=desc][&q=<表达式>]
+//   POST   /students                            请求体为数据文件中的一行
+//   DELETE /students/<id>
+// search 与 top 结果最多返回 limit 条（默认 100），count 为匹配总数
+class QueryServer {
+public:
+    explicit QueryServer(StudentManager& manager);
+    ~QueryServer();
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    // 只监听回环地址；threads 为 0 时按 CPU 核数
+    bool start(uint16_t port, size_t threads = 0);
+    // 阻塞运行事件循环，直到 stop() 或收到 SIGINT / SIGTERM
+    void run();
+    void stop();
+
+    uint16_t port() const { return boundPort; }
+    const std::string& lastError() const { return error; }
+
+    // 处理一个完整请求，返回 HTTP 状态码并把 JSON 写入 body；不涉及套接字，便于单独调用
+    int handle(const std::string& method, const std::string& target,
+               const std::string& requestBody, std::string& body);
+
+private:
+    StudentManager& manager;
+    std::shared_mutex lock;
+    int listenFd;
+    int epollFd;
+    int wakeFd;         // stop() 通过 eventfd 唤醒事件循环
+    uint16_t boundPort;
+    size_t threadCount;
+    std::atomic<bool> stopping;
+    std::string error;
+
+    struct Connection;
+    std::unordered_set<Connection*> connections;  // 关闭时释放仍打开的连接
+    std::mutex connectionsMutex;
+
+    void acceptClients();
+    void serve(Connection* connection, bool writable);
+    bool rearm(Connection* connection, bool wantWrite);
+    void closeConnection(Connection* connection);
+};
+
+#endif // QUERY_SERVER_HPP
@@ -0,0 +1,51 @@
+#ifndef RANK_INDEX_HPP
+#define RANK_INDEX_HPP
+
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+// 平均分排名索引（按分数分桶的树状数组）
+// 平均分按 0.001 精度量化为桶号，超出 0~100 的归入两端的桶；
+// 同一桶内出现不同分数时，该桶另存各分数的人数，桶内按精确值比较，
+// 因此名次 = 1 + 分数严格更高的人数，与原有并列排名规则一致
+class RankIndex {
+public:
+    static const int MAX_KEY = 100000;  // 100.000 分
+
+    RankIndex();
+
+    static int keyOf(double averageScore);
+    static double scoreOf(int key);
+
+    void clear();
+    void insert(double averageScore);
+    void erase(double averageScore);
+    // 由平均分列整体重建：分块并行统计各桶人数，再线性建树
+    void build(const double* averageScores, size_t count);
+
+    int rankOf(double averageScore) const;        // O(log n)
+    size_t countAbove(double averageScore) const; // 分数严格更高的人数
+    double kthScore(size_t k) const;              // 第 k 高的平均分（k 从 1 开始），精确值
+    size_t size() const;
+    size_t memoryUsage() const;
+    // 名次表 table[key] = 1 + 桶号更高的人数，由各桶人数并行后缀扫描得到
+    void rankTable(std::vector<int>& table) const;
+    // 用名次表求名次：桶内只有一种分数时等于 table[key]，否则再加上桶内更高的人数
+    int rankOf(double averageScore, const std::vector<int>& table) const;
+
+private:
+    std::vector<int> tree;    // 下标从 1 开始
+    std::vector<int> counts;  // 各桶人数
+    std::vector<double> values;  // 各桶的分数（桶内只有一种分数时有效）
+    std::unordered_map<int, std::map<double, int>> mixed;  // 含多种分数的桶：分数 -> 人数
+    size_t total;
+
+    void add(int key, int delta);
+    void addValue(int key, double averageScore, int delta);
+    size_t prefix(int key) const;  // 桶号 <= key 的人数
+    size_t aboveInBucket(int key, double averageScore) const;  // 桶内分数严格更高的人数
+};
+
+#endif // RANK_INDEX_HPP
@@ -0,0 +1,38 @@
+#ifndef SCORE_COLUMNS_HPP
+#define SCORE_COLUMNS_HPP
+
+#include <cstddef>
+#include <vector>
+
+struct Student;
+
+// 列式成绩存储：每门课一个连续数组，与 StudentManager::students 按下标一一对应
+// 统计时只扫描需要的列，不再把整条 Student 记录拖进缓存
+class ScoreColumns {
+public:
+    enum Column { MATH, CPP, ENGLISH, LINEAR_ALGEBRA, POLITICAL, AVERAGE, COLUMN_COUNT };
+
+    void clear();
+    void reserve(size_t count);
+    void push(const Student& student);
+    void set(size_t slot, const Student& student);
+    void moveLastTo(size_t slot);  // 配合“末尾填补”式删除
+    void popBack();
+    size_t size() const { return columns[0].size(); }
+    size_t memoryUsage() const;
+
+    const double* data(Column column) const { return columns[column].data(); }
+
+private:
+    std::vector<double> columns[COLUMN_COUNT];
+};
+
+// 统计内核：运行时检测 CPU，优先使用 AVX2，其次 SSE2，否则标量实现
+class ScoreKernels {
+public:
+    static double sum(const double* values, size_t count);
+    static size_t countAtLeast(const double* values, size_t count, double threshold);
+    static const char* implementation();
+};
+
+#endif // SCORE_COLUMNS_HPP
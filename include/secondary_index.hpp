@@ -0,0 +1,60 @@
+#ifndef SECONDARY_INDEX_HPP
+#define SECONDARY_INDEX_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "intern_table.hpp"
+
+// 精确匹配索引：取值 -> 下标列表
+// 取值先经驻留表换成小整数编号，列表按编号存放，并按下标保存一列编号供整数比较、分组使用
+// 每个下标记录自己在列表中的位置，删除时与列表末尾交换，增删改都是 O(1)
+class CategoryIndex {
+public:
+    void clear();
+    void insert(uint32_t slot, const std::string& key);
+    void erase(uint32_t slot);
+    // students[from] 被移动到 students[to]（to 原有的记录已经 erase）
+    void move(uint32_t from, uint32_t to);
+
+    const std::vector<uint32_t>* find(const std::string& key) const;
+    const std::vector<uint32_t>* find(uint32_t id) const;
+
+    const InternTable& values() const { return table; }
+    uint32_t idOf(uint32_t slot) const { return slotIds[slot]; }
+    const uint32_t* ids() const { return slotIds.data(); }  // 按下标排列的取值编号
+    size_t memoryUsage() const;
+
+private:
+    InternTable table;
+    std::vector<std::vector<uint32_t>> postings;  // 编号 -> 下标列表
+    std::vector<uint32_t> positions;              // positions[slot] = slot 在其列表中的位置
+    std::vector<uint32_t> slotIds;                // slotIds[slot] = 取值编号
+};
+
+// 三元组（连续 3 字节）倒排索引，用于子串查询
+// 删除采用惰性方式：旧下标留在列表中，查询时总会回表校验，过期条目过多时整体重建
+class TrigramIndex {
+public:
+    void clear();
+    void insert(uint32_t slot, const std::string& value);
+    void markStale(size_t count = 1);
+    bool needsRebuild() const;
+    size_t liveCount() const { return live; }
+    size_t memoryUsage() const;
+
+    // 返回可能包含 pattern 的候选下标（已去重、升序）；pattern 少于 3 字节时无法使用索引
+    static bool usable(std::string_view pattern) { return pattern.size() >= 3; }
+    std::vector<uint32_t> candidates(std::string_view pattern) const;
+
+private:
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings;
+    size_t live = 0;
+    size_t stale = 0;
+
+    static uint32_t trigramAt(std::string_view text, size_t pos);
+};
+
+#endif // SECONDARY_INDEX_HPP
@@ -0,0 +1,39 @@
+#ifndef SORT_KEYS_HPP
+#define SORT_KEYS_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "query.hpp"
+
+struct Student;
+class InternTable;
+
+// 多列排序中的一列
+struct SortKey {
+    Query::Field field = Query::Field::Id;
+    bool ascending = true;
+};
+
+// 多列稳定排序
+// 先把每一列规整成可直接比较的无符号整数键（字符串按去掉公共前缀后的 8 字节打包前缀
+// 压成序号，浮点数翻转符号位），再对下标排列排序，比较时不再访问字符串和 Student 对象；
+// 各列键的位宽之和不超过 64 时拼成单个整数键；两位小数的成绩改用定点整数键，
+// 拼出的键不超过 44 位时用 LSD 基数排序，线性时间完成
+class SortKeys {
+public:
+    // 例如 "department, class, average desc"，列名与查询语法相同
+    static bool parse(const std::string& text, std::vector<SortKey>& keys, std::string& error);
+    // 已驻留的字符串列：按下标排列的编号及驻留表，排序时只需把驻留表排一次序
+    struct InternedColumn {
+        Query::Field field;
+        const uint32_t* ids;
+        const InternTable* values;
+    };
+
+    // 返回排序后的下标排列；所有键都相等的记录保持原有先后顺序
+    static std::vector<uint32_t> order(const std::vector<Student>& students, const std::vector<SortKey>& keys,
+                                       const std::vector<InternedColumn>& interned = {});
+};
+
+#endif // SORT_KEYS_HPP
@@ -0,0 +1,60 @@
+#ifndef STORAGE_HPP
+#define STORAGE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "student.hpp"
+#include "student_view.hpp"
+#include "backup_store.hpp"
+
+class Journal;
+
+// 数据文件格式
+enum class DataFormat {
+    Text,    // 以 | 分隔的文本
+    Binary   // 列式二进制（见 binary_format.hpp）
+};
+
+// 文件存储类
+class FileStorage {
+private:
+    std::string dataDir;      // 确保这个私有成员存在
+    std::string dataFile;
+    DataFormat format;
+    Journal* journal;
+    uint64_t snapshotSequence;  // 最近载入的快照所含的日志序号
+    void ensureDataDirectory();
+    bool writeTextFile(const StudentView& students, const std::string& path,
+                       uint64_t sequence = 0, bool durable = false);
+    bool readTextFile(const std::string& path, std::vector<Student>& students);
+    bool readDataFile(const std::string& path, std::vector<Student>& students, uint64_t* sequence = nullptr);
+    
+public:
+    FileStorage();
+    void setDataFile(const std::string& path);
+    void setFormat(DataFormat newFormat);
+    DataFormat getFormat() const;
+    const std::string& getDataFile() const;
+    
+    // 保存快照时记录日志序号并在落盘后截断日志
+    void setJournal(Journal* newJournal);
+    uint64_t getSnapshotSequence() const;
+    bool saveStudents(const StudentView& students);
+    std::vector<Student> loadStudents();
+    
+    // 增量备份与按时间点恢复
+    bool createBackup(const StudentView& students);
+    std::vector<BackupInfo> listBackups() const;
+    std::vector<Student> restoreBackup(int backupId);
+    
+    bool exportToCSV(const StudentView& students, const std::string& filename);
+    std::vector<Student> importFromCSV(const std::string& filename);
+    
+    // 文本格式导入导出及格式转换
+    bool exportToText(const StudentView& students, const std::string& filename);
+    std::vector<Student> importFromText(const std::string& filename);
+    bool convertDataFile(const std::string& from, const std::string& to);
+};
+
+#endif // STORAGE_HPP
@@ -2,7 +2,20 @@
 #define STUDENT_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <unordered_map>
+#include "rank_index.hpp"
+#include "score_columns.hpp"
+#include "secondary_index.hpp"
+
+class Journal;
+class Query;
+class CompiledQuery;
+class StudentView;
+class StudentBatch;
+struct BatchResult;
+struct SortKey;
 
 // 学生结构体定义
 struct Student {
@@ -34,23 +47,74 @@ struct Student {
     void calculateScores();
     std::string toString() const;
     static Student fromString(const std::string& str);
-    void display() const;
+    
+    // 快速路径：追加到调用者提供的缓冲区 / 解析到已有对象，不产生临时字符串
+    void appendTo(std::string& out) const;
+    static bool parse(std::string_view str, Student& student, const char** error = nullptr);
+};
+
+// 修改操作的结果：不向控制台输出，失败原因由调用者决定如何展示
+struct Status {
+    enum Code { Ok, DuplicateId, NotFound };
+    Code code = Ok;
+    std::string message;  // 失败时为可直接显示的原因
+    
+    bool ok() const { return code == Ok; }
+    explicit operator bool() const { return ok(); }
+    
+    // 各管理类共用的失败原因
+    static Status duplicateId(const std::string& id);
+    static Status notFound(const std::string& id);
 };
 
 // 学生管理系统类
 class StudentManager {
 private:
     std::vector<Student> students;
+    std::unordered_map<std::string, size_t> idIndex;  // 学号 -> students 下标
+    RankIndex rankIndex;                              // 平均分 -> 名次
+    ScoreColumns scores;                              // 列式成绩，与 students 下标对应
+    CategoryIndex departmentIndex;                    // 院系 -> 下标
+    CategoryIndex majorIndex;                         // 专业 -> 下标
+    CategoryIndex classIndex;                         // 班级 -> 下标
+    TrigramIndex idTrigrams;                          // 学号子串查询
+    TrigramIndex nameTrigrams;                        // 姓名子串查询
+    bool ranksDirty = false;                          // students[i].rank 是否过期
+    Journal* journal = nullptr;                       // 预写日志（可选）
     void updateRanks();
+    void refreshRanks();
+    void rebuildIndex();
+    void rebuildTrigrams();
+    void appendRecord(const Student& student);
+    void replaceAt(size_t slot, const Student& newStudent);
+    void removeAt(size_t slot);
+    void secondaryInsert(size_t slot);
+    void secondaryErase(size_t slot);
+    void secondaryMove(size_t from, size_t to);
+    std::vector<uint32_t> matchSlots(const std::string& field, const std::string& value) const;
+    std::vector<uint32_t> selectSlots(CompiledQuery& compiled) const;
     
 public:
     // 学生管理操作
-    bool addStudent(const Student& student);
-    bool deleteStudent(const std::string& id);
-    bool updateStudent(const std::string& id, const Student& newStudent);
-    Student* findStudent(const std::string& id);
-    std::vector<Student> getAllStudents() const;
-    std::vector<Student> findStudentsByCondition(const std::string& field, const std::string& value);
+    Status addStudent(const Student& student);
+    Status deleteStudent(const std::string& id);
+    Status updateStudent(const std::string& id, const Student& newStudent);
+    BatchResult apply(const StudentBatch& batch, bool atomic = true);  // 批量增删改，见 student_batch.hpp
+    Student* findStudent(const std::string& id);     // 指针在下一次修改后失效；多线程共享见 concurrent_manager.hpp
+    const Student* findStudent(const std::string& id) const;  // 只读查找，不刷新 rank 字段，名次用 getRank()
+    std::vector<Student> getAllStudents() const;    // 完整拷贝，需要独立副本时使用
+    
+    // 以下返回指向内部存储的只读视图（名次已刷新），任何修改操作之后失效
+    StudentView view();
+    StudentView findStudentsByCondition(const std::string& field, const std::string& value);
+    StudentView query(const Query& query);  // 组合查询，见 query.hpp
+    
+    // 排名查询
+    int getRank(const std::string& id) const;
+    StudentView getTopStudents(size_t k);
+    // 任一成绩列的前 k（highest）或后 k 名，可附加过滤条件；按该列排序，同分按存储顺序
+    StudentView selectTop(ScoreColumns::Column column, size_t k, bool highest = true,
+                          const Query* filter = nullptr);
     
     // 统计功能
     struct Statistics {
@@ -65,16 +129,42 @@ public:
         int failCount = 0;
     };
     
+    // 分组统计结果（按分组键升序）
+    struct GroupStatistics {
+        std::string key;
+        Statistics stats;
+    };
+    
     Statistics getStatistics() const;
-    void showFailingStudents() const;
+    // field: "department" / "major" / "class"
+    std::vector<GroupStatistics> getGroupedStatistics(const std::string& field) const;
+    StudentView getFailingStudents();  // 平均分低于 60
     
     // 排序功能
     void sortStudents(const std::string& by, bool ascending = true);
+    void sortStudents(const std::vector<SortKey>& keys);  // 多列稳定排序，见 sort_keys.hpp
+    
+    // 内存占用（字节，估算值）
+    struct MemoryReport {
+        size_t records = 0;
+        size_t recordBytes = 0;        // Student 数组本身
+        size_t stringHeapBytes = 0;    // 超出 SSO 的字符串堆
+        size_t indexBytes = 0;         // 列式成绩、排名索引、学号索引及二级索引
+        // 容量规划用的估算：同一份数据若存入 CompactStudentStore 的占用，
+        // 按记录大小计算，名册本身仍存放在 Student 数组中
+        size_t compactEstimateBytes = 0;
+        size_t compactEstimateExceptions = 0;  // 其中无法无损压缩的记录数
+    };
+    MemoryReport getMemoryReport() const;
     
     // 工具函数
     size_t getCount() const;
     void clear();
+    // 整体替换，不写日志：调用者随后应保存快照（快照落盘时截断日志），否则重启后仍是旧数据加日志
     void setStudents(const std::vector<Student>& newStudents);  // 确保这个声明存在
+    
+    // 之后的增删改都会写入日志；传 nullptr 关闭
+    void setJournal(Journal* newJournal);
 };
 
 #endif // STUDENT_HPP
\ No newline at end of file
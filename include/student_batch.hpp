@@ -0,0 +1,61 @@
+#ifndef STUDENT_BATCH_HPP
+#define STUDENT_BATCH_HPP
+
+#include <string>
+#include <vector>
+#include "student.hpp"
+
+// 批量修改：先收集增删改操作，由 StudentManager::apply 一次校验、一次应用，结束时只重排名一次
+//   StudentBatch batch;
+//   batch.add(s1); batch.update("2023001", s2); batch.remove("2023002");
+//   BatchResult result = manager.apply(batch);
+class StudentBatch {
+public:
+    void add(const Student& student);
+    void remove(const std::string& id);
+    void update(const std::string& id, const Student& student);
+
+    size_t size() const { return operations.size(); }
+    bool empty() const { return operations.empty(); }
+    void clear() { operations.clear(); }
+
+private:
+    struct Operation {
+        enum Kind { Add, Delete, Update } kind;
+        std::string id;   // 删除、修改的目标学号
+        Student student;  // 新增、修改后的记录
+    };
+    std::vector<Operation> operations;
+
+    // 按学号存在性校验一条操作，exists(id) 返回该学号当前是否存在；两种管理类共用
+    template <typename Exists>
+    static Status validate(const Operation& op, Exists&& exists) {
+        if (op.kind == Operation::Add) {
+            return exists(op.id) ? Status::duplicateId(op.id) : Status();
+        }
+        if (!exists(op.id)) {
+            return Status::notFound(op.id);
+        }
+        if (op.kind == Operation::Update && op.id != op.student.id && exists(op.student.id)) {
+            return Status::duplicateId(op.student.id);
+        }
+        return {};
+    }
+
+    friend class StudentManager;
+    friend class ConcurrentStudentManager;
+};
+
+// 单条失败的操作
+struct BatchError {
+    size_t index;         // 操作在批次中的序号（从 0 开始）
+    Status status;
+};
+
+struct BatchResult {
+    size_t applied = 0;
+    std::vector<BatchError> errors;
+    bool ok() const { return errors.empty(); }
+};
+
+#endif // STUDENT_BATCH_HPP
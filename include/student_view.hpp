@@ -0,0 +1,57 @@
+#ifndef STUDENT_VIEW_HPP
+#define STUDENT_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+#include "student.hpp"
+
+// 学生记录的只读视图，不复制记录本身
+// 要么是一段连续记录，要么是“基址 + 下标列表”（查询结果）
+// 视图指向 StudentManager 内部存储，之后的任何增删改、排序都会使其失效
+class StudentView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Student;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Student*;
+        using reference = const Student&;
+
+        iterator(const StudentView* view, size_t pos) : view(view), pos(pos) {}
+        reference operator*() const { return (*view)[pos]; }
+        pointer operator->() const { return &(*view)[pos]; }
+        iterator& operator++() { ++pos; return *this; }
+        iterator operator++(int) { iterator old = *this; ++pos; return old; }
+        bool operator==(const iterator& other) const { return pos == other.pos; }
+        bool operator!=(const iterator& other) const { return pos != other.pos; }
+
+    private:
+        const StudentView* view;
+        size_t pos;
+    };
+
+    StudentView() : base(nullptr), count(0) {}
+    StudentView(const std::vector<Student>& students)  // 允许从 vector 隐式转换
+        : base(students.data()), count(students.size()) {}
+    StudentView(const Student* base, size_t count) : base(base), count(count) {}
+    StudentView(const Student* base, std::shared_ptr<const std::vector<uint32_t>> slots)
+        : base(base), count(slots ? slots->size() : 0), slots(std::move(slots)) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const Student& operator[](size_t i) const { return slots ? base[(*slots)[i]] : base[i]; }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, count); }
+
+private:
+    const Student* base;
+    size_t count;
+    std::shared_ptr<const std::vector<uint32_t>> slots;
+};
+
+#endif // STUDENT_VIEW_HPP
@@ -1,11 +1,20 @@
 #include "student.hpp"
 #include "io.hpp"
+#include "journal.hpp"
+#include "query.hpp"
+#include "sort_keys.hpp"
+#ifdef SMS_WITH_SERVER
+#include "query_server.hpp"
+#endif
 #include <iostream>
+#include <cctype>
+#include <iomanip>
 #include <string>
 
 // 全局变量定义
 StudentManager studentManager;
 FileStorage fileStorage;
+Journal journal;
 
 // 函数声明（确保这些函数都有实现）
 void addStudent();
@@ -14,12 +23,41 @@ void updateStudent();
 void searchStudents();
 void showAllStudents();
 void showStatistics();
+void showGroupedStatistics();
+void showTopStudents();
+void showMemoryReport();
 void sortStudents();
 void backupData();
 void importExportData();
 void saveData();
 void reloadData();
 
+// 载入快照并重放其后的日志
+void loadData() {
+    studentManager.setJournal(nullptr);
+    fileStorage.setJournal(nullptr);
+    
+    auto loadedStudents = fileStorage.loadStudents();
+    studentManager.setStudents(loadedStudents);
+    
+    if (journal.isOpen() || journal.open(fileStorage.getDataFile() + ".journal", fileStorage.getSnapshotSequence())) {
+        size_t replayed = journal.replay(studentManager, fileStorage.getSnapshotSequence());
+        if (replayed > 0) {
+            std::cout << "Replayed " << replayed << " journal records\n";
+        }
+        studentManager.setJournal(&journal);
+        fileStorage.setJournal(&journal);
+    }
+}
+
+// 整体替换名册（导入、恢复备份）：保存一次快照代替逐条写日志，快照落盘后日志被截断
+void replaceStudents(const std::vector<Student>& students) {
+    studentManager.setStudents(students);
+    if (journal.isOpen()) {
+        fileStorage.saveStudents(studentManager.view());
+    }
+}
+
 // 安全的获取菜单选择
 int getMenuChoice() {
     std::string input;
@@ -62,9 +100,12 @@ void addStudent() {
     student.calculateScores();
     
     // 添加到管理器
-    if (studentManager.addStudent(student)) {
+    Status status = studentManager.addStudent(student);
+    if (status) {
         std::cout << "\n✅ Student added successfully!\n";
-        student.display();
+        DisplayHelper::displayStudent(student);
+    } else {
+        std::cout << "Error: " << status.message << "!\n";
     }
     
     DisplayHelper::pause();
@@ -80,11 +121,14 @@ void deleteStudent() {
     // 先查找学生
     Student* student = studentManager.findStudent(id);
     if (student) {
-        student->display();
+        DisplayHelper::displayStudent(*student);
         
         if (InputHelper::confirm("Are you sure you want to delete this student?")) {
-            if (studentManager.deleteStudent(id)) {
+            Status status = studentManager.deleteStudent(id);
+            if (status) {
                 std::cout << "\n Student deleted successfully!\n";
+            } else {
+                std::cout << "Error: " << status.message << "!\n";
             }
         }
     } else {
@@ -109,7 +153,7 @@ void updateStudent() {
     }
     
     std::cout << "\nCurrent student information:\n";
-    oldStudent->display();
+    DisplayHelper::displayStudent(*oldStudent);
     
     std::cout << "\nEnter new information (press Enter to keep current value):\n";
     
@@ -181,9 +225,12 @@ void updateStudent() {
     newStudent.calculateScores();
     
     // 更新学生信息
-    if (studentManager.updateStudent(oldId, newStudent)) {
+    Status status = studentManager.updateStudent(oldId, newStudent);
+    if (status) {
         std::cout << "\n Student information updated successfully!\n";
-        newStudent.display();
+        DisplayHelper::displayStudent(newStudent);
+    } else {
+        std::cout << "Error: " << status.message << "!\n";
     }
     
     DisplayHelper::pause();
@@ -200,10 +247,12 @@ void searchStudents() {
     std::cout << "3. Department\n";
     std::cout << "4. Major\n";
     std::cout << "5. Class\n";
+    std::cout << "6. Advanced query (e.g. major = SE and math < 60 and age between 19 and 21)\n";
     
-    int choice = InputHelper::getInt("Choose: ", 1, 5);
+    int choice = InputHelper::getInt("Choose: ", 1, 6);
     
     std::string field, value;
+    StudentView results;
     switch (choice) {
         case 1: field = "id"; break;
         case 2: field = "name"; break;
@@ -212,9 +261,20 @@ void searchStudents() {
         case 5: field = "class"; break;
     }
     
-    value = InputHelper::getString("Enter search keyword: ");
-    
-    auto results = studentManager.findStudentsByCondition(field, value);
+    if (choice == 6) {
+        std::string text = InputHelper::getString("Enter query: ");
+        Query query;
+        std::string error;
+        if (!Query::parse(text, query, error)) {
+            std::cout << "\nInvalid query: " << error << "\n";
+            DisplayHelper::pause();
+            return;
+        }
+        results = studentManager.query(query);
+    } else {
+        value = InputHelper::getString("Enter search keyword: ");
+        results = studentManager.findStudentsByCondition(field, value);
+    }
     
     if (results.empty()) {
         std::cout << "\nNo students found.\n";
@@ -227,7 +287,7 @@ void searchStudents() {
             std::string id = InputHelper::getString("Enter student ID: ");
             Student* student = studentManager.findStudent(id);
             if (student) {
-                student->display();
+                DisplayHelper::displayStudent(*student);
             } else {
                 std::cout << "Student not found!\n";
             }
@@ -242,15 +302,15 @@ void showAllStudents() {
     DisplayHelper::clearScreen();
     std::cout << "=== All Students ===\n\n";
     
-    auto students = studentManager.getAllStudents();
-    DisplayHelper::displayStudentTable(students);
+    auto students = studentManager.view();
+    DisplayHelper::displayStudentTable(students, true);
     
     // 查看详细信息选项
     if (!students.empty() && InputHelper::confirm("\nView detailed information of a student?")) {
         std::string id = InputHelper::getString("Enter student ID: ");
         Student* student = studentManager.findStudent(id);
         if (student) {
-            student->display();
+            DisplayHelper::displayStudent(*student);
         } else {
             std::cout << "Student not found!\n";
         }
@@ -270,6 +330,78 @@ void showStatistics() {
     DisplayHelper::pause();
 }
 
+// 分组统计
+void showGroupedStatistics() {
+    DisplayHelper::clearScreen();
+    std::cout << "=== Grouped Statistics ===\n\n";
+    
+    std::cout << "Group by:\n";
+    std::cout << "1. Department\n";
+    std::cout << "2. Major\n";
+    std::cout << "3. Class\n";
+    
+    int choice = InputHelper::getInt("Choose: ", 1, 3);
+    
+    std::string field, title;
+    switch (choice) {
+        case 1: field = "department"; title = "Department"; break;
+        case 2: field = "major"; title = "Major"; break;
+        case 3: field = "class"; title = "Class"; break;
+    }
+    
+    auto groups = studentManager.getGroupedStatistics(field);
+    DisplayHelper::displayGroupedStatistics(title, groups);
+    
+    DisplayHelper::pause();
+}
+
+// 前 K / 后 K 名
+void showTopStudents() {
+    DisplayHelper::clearScreen();
+    std::cout << "=== Top / Bottom Students ===\n\n";
+    
+    std::cout << "Score column:\n";
+    std::cout << "1. Advanced Math\n";
+    std::cout << "2. C++ Programming\n";
+    std::cout << "3. English\n";
+    std::cout << "4. Linear Algebra\n";
+    std::cout << "5. Political\n";
+    std::cout << "6. Average\n";
+    
+    int choice = InputHelper::getInt("Choose: ", 1, 6);
+    auto column = static_cast<ScoreColumns::Column>(choice - 1);
+    bool highest = InputHelper::getInt("1. Highest  2. Lowest: ", 1, 2) == 1;
+    int k = InputHelper::getInt("How many students (K): ", 1, 1000000);
+    
+    Query filter;
+    bool filtered = false;
+    if (InputHelper::confirm("Restrict to a query (e.g. major = SE)?")) {
+        std::string text = InputHelper::getString("Enter query: ");
+        std::string error;
+        if (!Query::parse(text, filter, error)) {
+            std::cout << "\nInvalid query: " << error << "\n";
+            DisplayHelper::pause();
+            return;
+        }
+        filtered = true;
+    }
+    
+    auto results = studentManager.selectTop(column, k, highest, filtered ? &filter : nullptr);
+    DisplayHelper::displayStudentTable(results, true);
+    
+    DisplayHelper::pause();
+}
+
+// 内存占用报告
+void showMemoryReport() {
+    DisplayHelper::clearScreen();
+    std::cout << "=== Memory Report ===\n";
+    
+    DisplayHelper::displayMemoryReport(studentManager.getMemoryReport());
+    
+    DisplayHelper::pause();
+}
+
 // 排序学生
 void sortStudents() {
     DisplayHelper::clearScreen();
@@ -282,11 +414,12 @@ void sortStudents() {
     std::cout << "4. Name (Descending)\n";
     std::cout << "5. Average Score (Ascending)\n";
     std::cout << "6. Average Score (Descending)\n";
+    std::cout << "7. Multiple columns (e.g. department, class, average desc)\n";
     
-    int choice = InputHelper::getInt("Choose: ", 1, 6);
+    int choice = InputHelper::getInt("Choose: ", 1, 7);
     
     std::string by;
-    bool ascending;
+    bool ascending = true;
     
     switch (choice) {
         case 1: by = "id"; ascending = true; break;
@@ -297,13 +430,25 @@ void sortStudents() {
         case 6: by = "score"; ascending = false; break;
     }
     
-    studentManager.sortStudents(by, ascending);
+    if (choice == 7) {
+        std::string text = InputHelper::getString("Sort columns: ");
+        std::vector<SortKey> keys;
+        std::string error;
+        if (!SortKeys::parse(text, keys, error)) {
+            std::cout << "\nInvalid sort columns: " << error << "\n";
+            DisplayHelper::pause();
+            return;
+        }
+        studentManager.sortStudents(keys);
+    } else {
+        studentManager.sortStudents(by, ascending);
+    }
     std::cout << "\n Students sorted!\n";
     
     // 显示排序后的结果
     if (InputHelper::confirm("Show sorted results?")) {
-        auto students = studentManager.getAllStudents();
-        DisplayHelper::displayStudentTable(students);
+        auto students = studentManager.view();
+        DisplayHelper::displayStudentTable(students, true);
     }
     
     DisplayHelper::pause();
@@ -314,8 +459,43 @@ void backupData() {
     DisplayHelper::clearScreen();
     std::cout << "=== Backup Data ===\n\n";
     
-    if (fileStorage.createBackup()) {
-        std::cout << "\n Data backup successful!\n";
+    std::cout << "1. Create backup\n";
+    std::cout << "2. List backups\n";
+    std::cout << "3. Restore from backup\n";
+    std::cout << "4. Return to main menu\n";
+    
+    int choice = InputHelper::getInt("Choose: ", 1, 4);
+    
+    if (choice == 1) {
+        if (fileStorage.createBackup(studentManager.view())) {
+            std::cout << "\n Data backup successful!\n";
+        }
+    } else if (choice == 2 || choice == 3) {
+        auto backups = fileStorage.listBackups();
+        if (backups.empty()) {
+            std::cout << "\nNo backups found.\n";
+            DisplayHelper::pause();
+            return;
+        }
+        
+        std::cout << "\n  #    Time                 Type         Changed  Removed\n";
+        for (const auto& info : backups) {
+            std::cout << "  " << std::left << std::setw(5) << info.id
+                      << std::setw(21) << info.timestamp
+                      << std::setw(13) << (info.full ? "full" : "incremental")
+                      << std::setw(9) << info.changed << info.removed << "\n";
+        }
+        
+        if (choice == 3) {
+            int id = InputHelper::getInt("\nRestore backup #: ", backups.front().id, backups.back().id);
+            if (InputHelper::confirm("Restore will overwrite current data. Continue?")) {
+                auto restored = fileStorage.restoreBackup(id);
+                if (!restored.empty()) {
+                    replaceStudents(restored);
+                    std::cout << "\n Data restored! Currently have " << studentManager.getCount() << " students\n";
+                }
+            }
+        }
     }
     
     DisplayHelper::pause();
@@ -328,14 +508,17 @@ void importExportData() {
     
     std::cout << "1. Export data to CSV\n";
     std::cout << "2. Import data from CSV\n";
-    std::cout << "3. Return to main menu\n";
+    std::cout << "3. Export data to text file\n";
+    std::cout << "4. Import data from text file\n";
+    std::cout << "5. Convert data file (text <-> binary)\n";
+    std::cout << "6. Return to main menu\n";
     
-    int choice = InputHelper::getInt("Choose: ", 1, 3);
+    int choice = InputHelper::getInt("Choose: ", 1, 6);
     
     if (choice == 1) {
         // 导出到CSV
         std::string filename = InputHelper::getString("Enter CSV filename (e.g., students.csv): ");
-        auto students = studentManager.getAllStudents();
+        auto students = studentManager.view();
         
         if (fileStorage.exportToCSV(students, filename)) {
             std::cout << "\n Data export successful!\n";
@@ -348,10 +531,38 @@ void importExportData() {
             auto importedStudents = fileStorage.importFromCSV(filename);
             
             if (!importedStudents.empty()) {
-                studentManager.setStudents(importedStudents);
+                replaceStudents(importedStudents);
+                std::cout << "\n Data import successful! Imported " << importedStudents.size() << " records\n";
+            }
+        }
+    } else if (choice == 3) {
+        // 导出为文本格式
+        std::string filename = InputHelper::getString("Enter text filename (e.g., students.txt): ");
+        auto students = studentManager.view();
+        
+        if (fileStorage.exportToText(students, filename)) {
+            std::cout << "\n Data export successful!\n";
+        }
+    } else if (choice == 4) {
+        // 从文本格式导入
+        std::string filename = InputHelper::getString("Enter text filename: ");
+        
+        if (InputHelper::confirm("Import will overwrite current data. Continue?")) {
+            auto importedStudents = fileStorage.importFromText(filename);
+            
+            if (!importedStudents.empty()) {
+                replaceStudents(importedStudents);
                 std::cout << "\n Data import successful! Imported " << importedStudents.size() << " records\n";
             }
         }
+    } else if (choice == 5) {
+        // 文本与二进制格式互转
+        std::string from = InputHelper::getString("Source file: ");
+        std::string to = InputHelper::getString("Target file: ");
+        
+        if (fileStorage.convertDataFile(from, to)) {
+            std::cout << "\n Conversion successful!\n";
+        }
     }
     
     DisplayHelper::pause();
@@ -362,7 +573,7 @@ void saveData() {
     DisplayHelper::clearScreen();
     std::cout << "=== Save Data ===\n\n";
     
-    auto students = studentManager.getAllStudents();
+    auto students = studentManager.view();
     if (fileStorage.saveStudents(students)) {
         std::cout << "\n Data saved successfully!\n";
     }
@@ -375,24 +586,298 @@ void reloadData() {
     DisplayHelper::clearScreen();
     std::cout << "=== Reload Data ===\n\n";
     
-    if (InputHelper::confirm("Reload will lose unsaved changes. Continue?")) {
-        auto loadedStudents = fileStorage.loadStudents();
-        studentManager.setStudents(loadedStudents);
+    if (InputHelper::confirm("Reload will discard in-memory changes that were not journaled. Continue?")) {
+        loadData();
         std::cout << "\n Data reloaded successfully! Currently have " << studentManager.getCount() << " students\n";
     }
     
     DisplayHelper::pause();
 }
 
+// ==================== 非交互命令模式 ====================
+// 供脚本和定时任务使用：不清屏、不暂停、不提示，任一命令失败即以非零状态退出
+//   StudentManagementSystem --load data/students.bin --query "average >= 90" --export top.csv
+//   StudentManagementSystem --commands < script.txt   （从标准输入逐行读取命令，省略前缀 --）
+
+namespace {
+
+enum class ArgKind { None, Optional, Required };
+
+struct CommandSpec {
+    const char* name;
+    ArgKind arg;
+    const char* help;
+};
+
+const CommandSpec COMMANDS[] = {
+    {"load",    ArgKind::Optional, "load [file]      Load the data file (default data/students.txt) and replay its journal"},
+    {"import",  ArgKind::Required, "import <file>    Replace all records with a .csv or text file"},
+    {"query",   ArgKind::Required, "query <expr>     Select matching records, e.g. \"major = CS and average >= 80\""},
+    {"all",     ArgKind::None,     "all              Select all records again"},
+    {"sort",    ArgKind::Required, "sort <columns>   Sort records, e.g. \"department, average desc\""},
+    {"show",    ArgKind::None,     "show             Print the selected records"},
+    {"count",   ArgKind::None,     "count            Print the number of selected records"},
+    {"top",     ArgKind::Required, "top <k>          Print the k selected records with the highest average"},
+    {"stats",   ArgKind::Optional, "stats [field]    Print statistics, optionally grouped by department, major or class"},
+    {"failing", ArgKind::None,     "failing          Print students with failing scores"},
+    {"add",     ArgKind::Required, "add <record>     Add a student given as a data file line"},
+    {"delete",  ArgKind::Required, "delete <id>      Delete a student"},
+    {"export",  ArgKind::Required, "export <file>    Write the selected records to .csv or text"},
+    {"save",    ArgKind::None,     "save             Save a snapshot of the data file"},
+    {"backup",  ArgKind::None,     "backup           Create a backup"},
+#ifdef SMS_WITH_SERVER
+    {"serve",   ArgKind::Required, "serve <port>     Serve HTTP/JSON queries on 127.0.0.1 until interrupted"},
+#endif
+    {"help",    ArgKind::None,     "help             Show this help"},
+};
+
+bool dataLoaded = false;
+bool selectionActive = false;
+Query selection;
+
+const CommandSpec* findCommand(const std::string& name) {
+    for (const auto& spec : COMMANDS) {
+        if (name == spec.name) return &spec;
+    }
+    return nullptr;
+}
+
+void printUsage(std::ostream& out) {
+    out << "Usage: StudentManagementSystem [--<command> [argument]]...\n"
+        << "       StudentManagementSystem [--load file] --commands < script\n"
+        << "Without arguments the interactive menu is started.\n\n"
+        << "Commands run in order; data is loaded before the first command that needs it:\n";
+    for (const auto& spec : COMMANDS) {
+        out << "  " << spec.help << "\n";
+    }
+}
+
+// 当前选中的记录：未执行 query 时为全部记录
+StudentView selectedStudents() {
+    return selectionActive ? studentManager.query(selection) : studentManager.view();
+}
+
+bool hasSuffix(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// 执行一条命令；失败时把原因写到 stderr 并返回 false
+bool runCommand(const std::string& name, const std::string& argument) {
+    const CommandSpec* spec = findCommand(name);
+    if (!spec) {
+        std::cerr << "Error: Unknown command '" << name << "' (try --help)\n";
+        return false;
+    }
+    if (spec->arg == ArgKind::Required && argument.empty()) {
+        std::cerr << "Error: Command '" << name << "' needs an argument\n";
+        return false;
+    }
+    
+    if (name == "help") {
+        printUsage(std::cout);
+        return true;
+    }
+    if (name == "load") {
+        if (!argument.empty()) {
+            journal.close();
+            fileStorage.setDataFile(argument);
+        }
+        loadData();
+        dataLoaded = true;
+        selectionActive = false;
+        return true;
+    }
+    if (!dataLoaded) {
+        loadData();
+        dataLoaded = true;
+    }
+    
+    if (name == "import") {
+        auto imported = hasSuffix(argument, ".csv") ? fileStorage.importFromCSV(argument)
+                                                    : fileStorage.importFromText(argument);
+        if (imported.empty()) {
+            std::cerr << "Error: Nothing imported from " << argument << "\n";
+            return false;
+        }
+        replaceStudents(imported);
+        selectionActive = false;
+        std::cout << "Imported " << imported.size() << " records\n";
+    } else if (name == "query") {
+        std::string error;
+        if (!Query::parse(argument, selection, error)) {
+            std::cerr << "Error: Invalid query: " << error << "\n";
+            return false;
+        }
+        selectionActive = true;
+        std::cout << studentManager.query(selection).size() << " students matched\n";
+    } else if (name == "all") {
+        selectionActive = false;
+    } else if (name == "sort") {
+        std::vector<SortKey> keys;
+        std::string error;
+        if (!SortKeys::parse(argument, keys, error)) {
+            std::cerr << "Error: Invalid sort columns: " << error << "\n";
+            return false;
+        }
+        studentManager.sortStudents(keys);
+    } else if (name == "show") {
+        DisplayHelper::displayStudentTable(selectedStudents(), true);
+    } else if (name == "count") {
+        std::cout << selectedStudents().size() << "\n";
+    } else if (name == "top") {
+        int k = 0;
+        try {
+            k = std::stoi(argument);
+        } catch (const std::exception&) {
+        }
+        if (k <= 0) {
+            std::cerr << "Error: Invalid count '" << argument << "'\n";
+            return false;
+        }
+        auto top = studentManager.selectTop(ScoreColumns::AVERAGE, k, true,
+                                            selectionActive ? &selection : nullptr);
+        DisplayHelper::displayStudentTable(top, true);
+    } else if (name == "stats") {
+        if (argument.empty()) {
+            DisplayHelper::displayStatistics(studentManager.getStatistics());
+        } else if (argument == "department" || argument == "major" || argument == "class") {
+            std::string title = argument;
+            title[0] = static_cast<char>(toupper(title[0]));
+            DisplayHelper::displayGroupedStatistics(title, studentManager.getGroupedStatistics(argument));
+        } else {
+            std::cerr << "Error: Cannot group by '" << argument << "'\n";
+            return false;
+        }
+    } else if (name == "failing") {
+        DisplayHelper::displayFailingStudents(studentManager.getFailingStudents());
+    } else if (name == "add") {
+        Student student;
+        const char* error = nullptr;
+        if (!Student::parse(argument, student, &error)) {
+            std::cerr << "Error: Invalid student record: " << (error ? error : "malformed") << "\n";
+            return false;
+        }
+        student.calculateScores();
+        Status status = studentManager.addStudent(student);
+        if (!status) {
+            std::cerr << "Error: " << status.message << "\n";
+            return false;
+        }
+    } else if (name == "delete") {
+        Status status = studentManager.deleteStudent(argument);
+        if (!status) {
+            std::cerr << "Error: " << status.message << "\n";
+            return false;
+        }
+    } else if (name == "export") {
+        auto students = selectedStudents();
+        bool ok = hasSuffix(argument, ".csv") ? fileStorage.exportToCSV(students, argument)
+                                              : fileStorage.exportToText(students, argument);
+        if (!ok) return false;
+    } else if (name == "save") {
+        if (!fileStorage.saveStudents(studentManager.view())) return false;
+    } else if (name == "backup") {
+        if (!fileStorage.createBackup(studentManager.view())) return false;
+#ifdef SMS_WITH_SERVER
+    } else if (name == "serve") {
+        int port = 0;
+        try {
+            port = std::stoi(argument);
+        } catch (const std::exception&) {
+        }
+        if (port < 0 || port > 65535) {
+            std::cerr << "Error: Invalid port '" << argument << "'\n";
+            return false;
+        }
+        QueryServer server(studentManager);
+        if (!server.start(static_cast<uint16_t>(port))) {
+            std::cerr << "Error: " << server.lastError() << "\n";
+            return false;
+        }
+        std::cout << "Serving " << studentManager.getCount() << " students on http://127.0.0.1:"
+                  << server.port() << " (Ctrl+C to stop)" << std::endl;
+        server.run();
+        std::cout << "Server stopped\n";
+#endif
+    }
+    
+    if (journal.needsCompaction()) {
+        fileStorage.saveStudents(studentManager.view());
+    }
+    return true;
+}
+
+// 从输入流逐行读取命令；空行和 # 开头的行被忽略
+int runScript(std::istream& in) {
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        size_t begin = line.find_first_not_of(" \t\r");
+        if (begin == std::string::npos || line[begin] == '#') continue;
+        size_t end = line.find_last_not_of(" \t\r") + 1;
+        
+        size_t split = line.find_first_of(" \t", begin);
+        if (split == std::string::npos || split > end) split = end;
+        std::string name = line.substr(begin, split - begin);
+        if (name.compare(0, 2, "--") == 0) name.erase(0, 2);
+        if (name == "exit" || name == "quit") break;
+        
+        size_t valueBegin = line.find_first_not_of(" \t", split);
+        std::string value = valueBegin < end ? line.substr(valueBegin, end - valueBegin) : "";
+        if (!runCommand(name, value)) {
+            std::cerr << "(line " << lineNumber << ")\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// --name [value] 形式的参数；可选参数只在下一个参数不以 -- 开头时读取
+int runArguments(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h") arg = "--help";
+        if (arg.compare(0, 2, "--") != 0) {
+            std::cerr << "Error: Unexpected argument '" << arg << "' (try --help)\n";
+            return 2;
+        }
+        std::string name = arg.substr(2);
+        if (name == "commands") {
+            int status = runScript(std::cin);
+            if (status != 0) return status;
+            continue;
+        }
+        const CommandSpec* spec = findCommand(name);
+        std::string value;
+        if (spec && spec->arg != ArgKind::None && i + 1 < argc
+            && (spec->arg == ArgKind::Required || std::string(argv[i + 1]).compare(0, 2, "--") != 0)) {
+            value = argv[++i];
+        }
+        if (!runCommand(name, value)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
 // 主函数
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        DisplayHelper::setInteractive(false);
+        int status = runArguments(argc, argv);
+        journal.close();
+        return status;
+    }
+    
     // 显示欢迎信息
     DisplayHelper::showWelcome();
     
     // 加载已有数据
     std::cout << "\nLoading data..." << std::endl;
-    auto loadedStudents = fileStorage.loadStudents();
-    studentManager.setStudents(loadedStudents);
+    loadData();
     std::cout << "System loaded " << studentManager.getCount() << " student records" << std::endl;
     
     DisplayHelper::pause();
@@ -413,12 +898,15 @@ int main() {
             case 4: searchStudents(); break;
             case 5: showAllStudents(); break;
             case 6: showStatistics(); break;
-            case 7: studentManager.showFailingStudents(); DisplayHelper::pause(); break;
+            case 7: DisplayHelper::displayFailingStudents(studentManager.getFailingStudents()); DisplayHelper::pause(); break;
             case 8: sortStudents(); break;
             case 9: backupData(); break;
             case 10: importExportData(); break;
             case 11: saveData(); break;
             case 12: reloadData(); break;
+            case 13: showGroupedStatistics(); break;
+            case 14: showTopStudents(); break;
+            case 15: showMemoryReport(); break;
             case 0: 
                 std::cout << "\nSave data before exiting? (Y/N): ";
                 if (InputHelper::confirm("Save data and exit?")) {
@@ -431,7 +919,14 @@ int main() {
                 std::cout << "Invalid choice, please try again!\n";
                 DisplayHelper::pause();
         }
+        
+        // 日志过长时生成快照
+        if (journal.needsCompaction()) {
+            fileStorage.saveStudents(studentManager.view());
+        }
     }
     
+    journal.close();
+    
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,324 @@
+#include "backup_store.hpp"
+#include "buffered_writer.hpp"
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// FNV-1a 64 位哈希
+uint64_t hashBytes(const char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// 记录内容哈希：对文本格式去掉最后的名次字段后求哈希
+uint64_t recordHash(const Student& student, std::string& buffer) {
+    buffer.clear();
+    student.appendTo(buffer);
+    size_t end = buffer.rfind('|');
+    return hashBytes(buffer.data(), end == std::string::npos ? buffer.size() : end);
+}
+
+// 整个字段都是数字才算解析成功
+template <typename T>
+bool parseNumber(std::string_view text, T& value, int base = 10) {
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, value, base);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+std::string currentTimestamp(const char* dateSep, const char* timeSep, const char* middle) {
+    auto time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm tm = *std::localtime(&time);
+    
+    std::ostringstream oss;
+    oss << (tm.tm_year + 1900) << dateSep
+        << std::setfill('0') << std::setw(2) << (tm.tm_mon + 1) << dateSep
+        << std::setw(2) << tm.tm_mday << middle
+        << std::setw(2) << tm.tm_hour << timeSep
+        << std::setw(2) << tm.tm_min << timeSep
+        << std::setw(2) << tm.tm_sec;
+    return oss.str();
+}
+
+} // namespace
+
+BackupStore::BackupStore(const std::string& dir) : dir(dir) {}
+
+std::string BackupStore::manifestPath() const {
+    return (fs::path(dir) / "manifest.txt").string();
+}
+
+std::string BackupStore::hashesPath() const {
+    return (fs::path(dir) / "hashes.txt").string();
+}
+
+// manifest 每行：id|时间|F/I|变化数|删除数|文件名
+std::vector<BackupInfo> BackupStore::list() const {
+    std::vector<BackupInfo> infos;
+    std::ifstream file(manifestPath());
+    std::string line;
+    int lineNumber = 0;
+    
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::istringstream iss(line);
+        std::string token;
+        std::vector<std::string> tokens;
+        while (std::getline(iss, token, '|')) {
+            tokens.push_back(token);
+        }
+        
+        BackupInfo info;
+        bool valid = tokens.size() >= 6 && parseNumber(tokens[0], info.id)
+                  && parseNumber(tokens[3], info.changed) && parseNumber(tokens[4], info.removed);
+        if (!valid) {
+            // 损坏的行跳过，其余备份仍可列出和恢复
+            std::cerr << "Warning: Backup manifest " << manifestPath() << " line " << lineNumber
+                      << " is corrupted, ignored\n";
+            continue;
+        }
+        info.timestamp = tokens[1];
+        info.full = tokens[2] == "F";
+        info.file = tokens[5];
+        infos.push_back(info);
+    }
+    return infos;
+}
+
+// hashes.txt：首行 "# Backup <id>"，其后每行 学号|哈希；没有首行的旧文件视为备份号 0
+// 有损坏的行时整个哈希表作废，返回 false，调用方改做全量备份
+bool BackupStore::loadHashes(int& backupId, std::vector<std::pair<std::string, uint64_t>>& hashes) const {
+    std::ifstream file(hashesPath());
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    backupId = 0;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (!line.empty() && line[0] == '#') {
+            std::sscanf(line.c_str(), "# Backup %d", &backupId);
+            continue;
+        }
+        
+        size_t sep = line.rfind('|');
+        uint64_t hash = 0;
+        if (sep == std::string::npos || !parseNumber(std::string_view(line).substr(sep + 1), hash, 16)) {
+            std::cerr << "Warning: Backup hashes " << hashesPath() << " line " << lineNumber
+                      << " is corrupted, making a full backup\n";
+            hashes.clear();
+            return false;
+        }
+        hashes.emplace_back(line.substr(0, sep), hash);
+    }
+    return true;
+}
+
+bool BackupStore::saveHashes(int backupId, const StudentView& students,
+                             const std::vector<uint64_t>& hashes) const {
+    std::string tempPath = hashesPath() + ".tmp";
+    BufferedWriter writer;
+    if (!writer.open(tempPath)) {
+        return false;
+    }
+    
+    writer.buffer() += "# Backup " + std::to_string(backupId) + "\n";
+    char hex[20];
+    for (size_t i = 0; i < students.size(); i++) {
+        std::snprintf(hex, sizeof(hex), "|%016llx\n", static_cast<unsigned long long>(hashes[i]));
+        writer.buffer() += students[i].id;
+        writer.buffer() += hex;
+        writer.commitIfFull();
+    }
+    if (!writer.sync() || !writer.close()) {
+        return false;
+    }
+    
+    std::error_code ec;
+    fs::rename(tempPath, hashesPath(), ec);
+    return !ec;
+}
+
+bool BackupStore::create(const StudentView& students, BackupInfo& info, std::string& error) {
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    
+    std::vector<BackupInfo> infos = list();
+    info = BackupInfo();
+    info.id = infos.empty() ? 1 : infos.back().id + 1;
+    info.timestamp = currentTimestamp("-", ":", " ");
+    
+    // 距上次全量备份达到间隔，或哈希表缺失、不是上一次备份的哈希表时做全量备份
+    int lastFull = 0;
+    for (const auto& previous : infos) {
+        if (previous.full) lastFull = previous.id;
+    }
+    std::vector<std::pair<std::string, uint64_t>> previousHashes;
+    int hashesId = 0;
+    info.full = lastFull == 0 || info.id - lastFull >= FULL_BACKUP_INTERVAL
+             || !loadHashes(hashesId, previousHashes) || hashesId != infos.back().id;
+    
+    std::unordered_map<std::string, uint64_t> previous;
+    if (!info.full) {
+        previous.reserve(previousHashes.size());
+        for (auto& entry : previousHashes) {
+            previous.emplace(std::move(entry.first), entry.second);
+        }
+    }
+    
+    info.file = "backup_" + std::to_string(info.id) + "_" + currentTimestamp("-", "-", "_") + ".txt";
+    std::string path = (fs::path(dir) / info.file).string();
+    
+    BufferedWriter writer;
+    if (!writer.open(path)) {
+        error = "cannot create " + path;
+        return false;
+    }
+    writer.buffer() += "# Backup " + std::to_string(info.id) + (info.full ? " full\n" : " incremental\n");
+    
+    // 新增或内容变化的记录
+    std::vector<uint64_t> hashes(students.size());
+    std::string buffer;
+    for (size_t i = 0; i < students.size(); i++) {
+        hashes[i] = recordHash(students[i], buffer);
+        if (!info.full) {
+            auto found = previous.find(students[i].id);
+            bool unchanged = found != previous.end() && found->second == hashes[i];
+            if (found != previous.end()) {
+                previous.erase(found);
+            }
+            if (unchanged) continue;
+        }
+        
+        writer.buffer() += '+';
+        writer.buffer() += buffer;
+        writer.buffer() += '\n';
+        writer.commitIfFull();
+        info.changed++;
+    }
+    
+    // 剩下的就是被删除的学号
+    for (const auto& entry : previous) {
+        writer.buffer() += '-';
+        writer.buffer() += entry.first;
+        writer.buffer() += '\n';
+        writer.commitIfFull();
+        info.removed++;
+    }
+    
+    if (!writer.sync() || !writer.close()) {
+        error = "failed to write " + path;
+        return false;
+    }
+    
+    // 先登记 manifest 再更新哈希表；两步之间崩溃时哈希表仍是上一次备份的，
+    // 其备份号与 manifest 不符，下次备份会改做全量备份，而不是与过期的哈希表比较
+    std::ofstream manifest(manifestPath(), std::ios::app);
+    manifest << info.id << "|" << info.timestamp << "|" << (info.full ? "F" : "I") << "|"
+             << info.changed << "|" << info.removed << "|" << info.file << "\n";
+    manifest.close();
+    if (!manifest) {
+        error = "failed to update manifest";
+        return false;
+    }
+    
+    if (!saveHashes(info.id, students, hashes)) {
+        error = "failed to update record hashes";
+        return false;
+    }
+    return true;
+}
+
+bool BackupStore::applyBackupFile(const BackupInfo& info, std::vector<Student>& students,
+                                  std::vector<bool>& alive, std::string& error) const {
+    std::ifstream file((fs::path(dir) / info.file).string());
+    if (!file.is_open()) {
+        error = "missing backup file " + info.file;
+        return false;
+    }
+    
+    // 学号 -> students 下标
+    std::unordered_map<std::string, size_t> slots;
+    slots.reserve(students.size());
+    for (size_t i = 0; i < students.size(); i++) {
+        if (alive[i]) slots.emplace(students[i].id, i);
+    }
+    
+    std::string line;
+    Student student;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        
+        if (line[0] == '-') {
+            auto found = slots.find(line.substr(1));
+            if (found != slots.end()) {
+                alive[found->second] = false;
+                slots.erase(found);
+            }
+        } else if (line[0] == '+' && Student::parse(std::string_view(line).substr(1), student)) {
+            auto found = slots.find(student.id);
+            if (found != slots.end()) {
+                students[found->second] = student;
+            } else {
+                slots.emplace(student.id, students.size());
+                students.push_back(student);
+                alive.push_back(true);
+            }
+        }
+    }
+    return true;
+}
+
+bool BackupStore::restore(int id, std::vector<Student>& students, std::string& error) const {
+    std::vector<BackupInfo> infos = list();
+    
+    // 找到不晚于目标的最近一次全量备份
+    int target = -1;
+    int base = -1;
+    for (size_t i = 0; i < infos.size(); i++) {
+        if (infos[i].id > id) break;
+        if (infos[i].full) base = static_cast<int>(i);
+        if (infos[i].id == id) target = static_cast<int>(i);
+    }
+    if (target < 0) {
+        error = "backup " + std::to_string(id) + " not found";
+        return false;
+    }
+    if (base < 0) {
+        error = "no full backup before backup " + std::to_string(id);
+        return false;
+    }
+    
+    std::vector<Student> rebuilt;
+    std::vector<bool> alive;
+    for (int i = base; i <= target; i++) {
+        if (!applyBackupFile(infos[i], rebuilt, alive, error)) {
+            return false;
+        }
+    }
+    
+    students.clear();
+    students.reserve(rebuilt.size());
+    for (size_t i = 0; i < rebuilt.size(); i++) {
+        if (alive[i]) students.push_back(std::move(rebuilt[i]));
+    }
+    return true;
+}
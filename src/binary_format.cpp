@@ -0,0 +1,236 @@
+#include "binary_format.hpp"
+#include "mapped_file.hpp"
+#include "buffered_writer.hpp"
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+const int DOUBLE_COLUMNS = 7;
+const int STRING_COLUMNS = 5;
+
+struct FileHeaderV1 {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t reserved;
+    uint64_t count;
+    uint64_t heapSize;
+};
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t reserved;
+    uint64_t count;
+    uint64_t heapSize;
+    uint64_t sequence;  // v2 起：快照包含的最后一条日志序号
+};
+
+struct StringRef {
+    uint32_t offset;
+    uint32_t length;
+};
+
+size_t align8(size_t n) {
+    return (n + 7) & ~size_t(7);
+}
+
+// 各列在文件中的偏移
+struct Layout {
+    size_t doubles[DOUBLE_COLUMNS];
+    size_t age;
+    size_t rank;
+    size_t gender;
+    size_t strings[STRING_COLUMNS];
+    size_t heap;
+    size_t end;
+
+    Layout(uint64_t count, uint64_t heapSize, size_t headerSize) {
+        size_t pos = align8(headerSize);
+        for (auto& column : doubles) {
+            column = pos;
+            pos += align8(count * sizeof(double));
+        }
+        age = pos;
+        pos += align8(count * sizeof(int32_t));
+        rank = pos;
+        pos += align8(count * sizeof(int32_t));
+        gender = pos;
+        pos += align8(count);
+        for (auto& column : strings) {
+            column = pos;
+            pos += align8(count * sizeof(StringRef));
+        }
+        heap = pos;
+        end = pos + heapSize;
+    }
+};
+
+double Student::* const doubleFields[DOUBLE_COLUMNS] = {
+    &Student::math, &Student::cpp, &Student::english, &Student::linearAlgebra,
+    &Student::political, &Student::totalScore, &Student::averageScore
+};
+
+std::string Student::* const stringFields[STRING_COLUMNS] = {
+    &Student::id, &Student::name, &Student::department, &Student::major, &Student::className
+};
+
+template <typename T>
+void put(std::vector<char>& buffer, size_t offset, const T& value) {
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T get(const char* base, size_t offset) {
+    T value;
+    std::memcpy(&value, base + offset, sizeof(T));
+    return value;
+}
+
+} // namespace
+
+bool BinaryFormat::isBinaryFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    uint32_t magic = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    return file && magic == MAGIC;
+}
+
+bool BinaryFormat::save(const StudentView& students, const std::string& path, std::string& error,
+                        uint64_t sequence, bool durable) {
+    uint64_t count = students.size();
+    uint64_t heapSize = 0;
+    for (const auto& student : students) {
+        for (auto field : stringFields) {
+            heapSize += (student.*field).size();
+        }
+    }
+    if (heapSize > UINT32_MAX) {
+        error = "string heap exceeds 4 GiB";
+        return false;
+    }
+    
+    Layout layout(count, heapSize, sizeof(FileHeader));
+    std::vector<char> buffer(layout.end, 0);
+    
+    FileHeader header = {MAGIC, VERSION, BYTE_ORDER_MARK, 0, count, heapSize, sequence};
+    put(buffer, 0, header);
+    
+    uint32_t heapPos = 0;
+    for (size_t i = 0; i < count; i++) {
+        const Student& student = students[i];
+        for (int c = 0; c < DOUBLE_COLUMNS; c++) {
+            put(buffer, layout.doubles[c] + i * sizeof(double), student.*doubleFields[c]);
+        }
+        put(buffer, layout.age + i * sizeof(int32_t), static_cast<int32_t>(student.age));
+        put(buffer, layout.rank + i * sizeof(int32_t), static_cast<int32_t>(student.rank));
+        buffer[layout.gender + i] = student.gender;
+        
+        for (int c = 0; c < STRING_COLUMNS; c++) {
+            const std::string& value = student.*stringFields[c];
+            StringRef ref = {heapPos, static_cast<uint32_t>(value.size())};
+            put(buffer, layout.strings[c] + i * sizeof(StringRef), ref);
+            std::memcpy(buffer.data() + layout.heap + heapPos, value.data(), value.size());
+            heapPos += ref.length;
+        }
+    }
+    
+    BufferedWriter writer;
+    if (!writer.open(path)) {
+        error = "cannot open file for writing";
+        return false;
+    }
+    writer.append(buffer.data(), buffer.size());
+    if ((durable && !writer.sync()) || !writer.close()) {
+        error = "write failed";
+        return false;
+    }
+    return true;
+}
+
+bool BinaryFormat::load(const std::string& path, std::vector<Student>& students, std::string& error,
+                        uint64_t* sequence) {
+    MappedFile file;
+    if (!file.open(path)) {
+        error = "cannot open file";
+        return false;
+    }
+    if (file.size() < sizeof(FileHeaderV1)) {
+        error = "file too small";
+        return false;
+    }
+    
+    const char* base = file.data();
+    FileHeader header = {};
+    std::memcpy(&header, base, sizeof(FileHeaderV1));
+    if (header.magic != MAGIC) {
+        error = "not a binary data file";
+        return false;
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        error = "byte order mismatch";
+        return false;
+    }
+    
+    // v1 文件没有日志序号
+    size_t headerSize = sizeof(FileHeaderV1);
+    if (header.version == VERSION) {
+        if (file.size() < sizeof(FileHeader)) {
+            error = "file too small";
+            return false;
+        }
+        header = get<FileHeader>(base, 0);
+        headerSize = sizeof(FileHeader);
+    } else if (header.version != 1) {
+        error = "unsupported version " + std::to_string(header.version);
+        return false;
+    }
+    if (sequence) {
+        *sequence = header.sequence;
+    }
+    
+    // 先按 count 粗略校验，避免 Layout 计算溢出
+    if (header.count > file.size() || header.heapSize > file.size()) {
+        error = "corrupted header";
+        return false;
+    }
+    Layout layout(header.count, header.heapSize, headerSize);
+    if (layout.end > file.size()) {
+        error = "file truncated";
+        return false;
+    }
+    
+    const char* heap = base + layout.heap;
+    size_t count = header.count;
+    students.clear();
+    students.resize(count);
+    
+    // 按列填充，每列顺序访问
+    for (int c = 0; c < DOUBLE_COLUMNS; c++) {
+        const char* column = base + layout.doubles[c];
+        for (size_t i = 0; i < count; i++) {
+            students[i].*doubleFields[c] = get<double>(column, i * sizeof(double));
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        students[i].age = get<int32_t>(base, layout.age + i * sizeof(int32_t));
+        students[i].rank = get<int32_t>(base, layout.rank + i * sizeof(int32_t));
+        students[i].gender = base[layout.gender + i];
+    }
+    for (int c = 0; c < STRING_COLUMNS; c++) {
+        const char* column = base + layout.strings[c];
+        for (size_t i = 0; i < count; i++) {
+            StringRef ref = get<StringRef>(column, i * sizeof(StringRef));
+            if (uint64_t(ref.offset) + ref.length > header.heapSize) {
+                error = "string reference out of range at record " + std::to_string(i + 1);
+                students.clear();
+                return false;
+            }
+            (students[i].*stringFields[c]).assign(heap + ref.offset, ref.length);
+        }
+    }
+    return true;
+}
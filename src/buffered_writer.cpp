@@ -0,0 +1,132 @@
+#include "buffered_writer.hpp"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+BufferedWriter::BufferedWriter(size_t capacity, bool background)
+    : file(nullptr), capacity(capacity), background(background), failed(false),
+      hasPending(false), stopping(false) {
+    current.reserve(capacity + 4096);
+}
+
+BufferedWriter::~BufferedWriter() {
+    close();
+}
+
+bool BufferedWriter::open(const std::string& path, bool appendMode) {
+    close();
+    file = std::fopen(path.c_str(), appendMode ? "ab" : "wb");
+    if (!file) {
+        return false;
+    }
+    
+    // 自己管理缓冲，关闭 stdio 的缓冲
+    std::setvbuf(file, nullptr, _IONBF, 0);
+    failed = false;
+    stopping = false;
+    if (background) {
+        pending.reserve(capacity + 4096);
+        ioThread = std::thread(&BufferedWriter::ioLoop, this);
+    }
+    return true;
+}
+
+void BufferedWriter::append(const char* data, size_t size) {
+    current.append(data, size);
+    commitIfFull();
+}
+
+void BufferedWriter::writeOut(const std::string& data) {
+    if (!data.empty() && std::fwrite(data.data(), 1, data.size(), file) != data.size()) {
+        failed = true;
+    }
+}
+
+// 提交当前缓冲区：同步模式直接写出，后台模式与 pending 交换后唤醒 I/O 线程
+void BufferedWriter::commit() {
+    if (!file || current.empty()) return;
+    
+    if (!background) {
+        writeOut(current);
+        current.clear();
+        return;
+    }
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this] { return !hasPending; });
+    pending.swap(current);
+    hasPending = true;
+    lock.unlock();
+    condition.notify_all();
+    current.clear();
+}
+
+void BufferedWriter::ioLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        condition.wait(lock, [this] { return hasPending || stopping; });
+        if (!hasPending) {
+            return;
+        }
+        
+        // 写盘期间不持锁，格式化线程可以继续填充 current
+        lock.unlock();
+        writeOut(pending);
+        lock.lock();
+        pending.clear();
+        hasPending = false;
+        condition.notify_all();
+    }
+}
+
+bool BufferedWriter::sync() {
+    if (!file) {
+        return false;
+    }
+    
+    commit();
+    if (background) {
+        // 等待后台线程写完
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] { return !hasPending; });
+    }
+    
+    if (std::fflush(file) != 0) {
+        failed = true;
+    }
+#ifdef _WIN32
+    if (_commit(_fileno(file)) != 0) {
+        failed = true;
+    }
+#else
+    if (fsync(fileno(file)) != 0) {
+        failed = true;
+    }
+#endif
+    return !failed;
+}
+
+bool BufferedWriter::close() {
+    if (!file) {
+        return !failed;
+    }
+    
+    commit();
+    if (ioThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition.notify_all();
+        ioThread.join();
+    }
+    
+    if (std::fclose(file) != 0) {
+        failed = true;
+    }
+    file = nullptr;
+    return !failed;
+}
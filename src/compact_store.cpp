@@ -0,0 +1,155 @@
+#include "compact_store.hpp"
+#include "memory_usage.hpp"
+#include <cmath>
+#include <limits>
+
+// ==================== CompactStudentStore 类实现 ====================
+
+namespace {
+
+double Student::* const scoreFields[5] = {
+    &Student::math, &Student::cpp, &Student::english, &Student::linearAlgebra, &Student::political
+};
+
+const size_t MAX_TEXT_LENGTH = std::numeric_limits<uint8_t>::max();
+const uint32_t MAX_CATEGORY_ID = std::numeric_limits<uint16_t>::max();
+const size_t MAX_TEXT_BYTES = std::numeric_limits<uint32_t>::max();
+
+// 旁路表中一条记录的占用：哈希表节点与桶（按负载因子 1 计）加上字符串堆
+size_t exceptionBytes(const Student& student) {
+    size_t bytes = sizeof(std::pair<const uint32_t, Student>) + 2 * sizeof(void*) + sizeof(size_t);
+    for (const std::string* field : {&student.id, &student.name, &student.department,
+                                     &student.major, &student.className}) {
+        bytes += MemoryUsage::heapBytes(*field);
+    }
+    return bytes;
+}
+
+} // namespace
+
+void CompactStudentStore::clear() {
+    records.clear();
+    text.clear();
+    departments.clear();
+    majors.clear();
+    classes.clear();
+    exceptions.clear();
+}
+
+void CompactStudentStore::reserve(size_t count, size_t textBytes) {
+    records.reserve(count);
+    text.reserve(textBytes);
+}
+
+// 两位小数且在 uint16 范围内才能无损存储
+bool CompactStudentStore::packScore(double score, uint16_t& packed) {
+    double scaled = std::round(score * 100.0);
+    if (!(scaled >= 0 && scaled <= std::numeric_limits<uint16_t>::max()) || scaled / 100.0 != score) {
+        return false;
+    }
+    packed = static_cast<uint16_t>(scaled);
+    return true;
+}
+
+bool CompactStudentStore::fitsRecord(const Student& student) {
+    uint16_t packed;
+    for (int c = 0; c < 5; c++) {
+        if (!packScore(student.*scoreFields[c], packed)) {
+            return false;
+        }
+    }
+    return (student.gender == 'M' || student.gender == 'F')
+        && student.age >= 0 && student.age <= 127
+        && student.id.size() <= MAX_TEXT_LENGTH && student.name.size() <= MAX_TEXT_LENGTH;
+}
+
+bool CompactStudentStore::fits(const Student& student) const {
+    return fitsRecord(student)
+        && text.size() + student.id.size() + student.name.size() <= MAX_TEXT_BYTES
+        && departments.size() <= MAX_CATEGORY_ID && majors.size() <= MAX_CATEGORY_ID
+        && classes.size() <= MAX_CATEGORY_ID;
+}
+
+void CompactStudentStore::push(const Student& student) {
+    Record record = {};
+    if (!fits(student)) {
+        record.flags = EXCEPTION;
+        exceptions.emplace(static_cast<uint32_t>(records.size()), student);
+        records.push_back(record);
+        return;
+    }
+    
+    for (int c = 0; c < 5; c++) {
+        packScore(student.*scoreFields[c], record.scores[c]);
+    }
+    record.idOffset = static_cast<uint32_t>(text.size());
+    record.idLength = static_cast<uint8_t>(student.id.size());
+    text += student.id;
+    record.nameOffset = static_cast<uint32_t>(text.size());
+    record.nameLength = static_cast<uint8_t>(student.name.size());
+    text += student.name;
+    
+    record.genderAge = static_cast<uint8_t>((student.gender == 'M' ? 0x80 : 0) | student.age);
+    record.department = static_cast<uint16_t>(departments.intern(student.department));
+    record.major = static_cast<uint16_t>(majors.intern(student.major));
+    record.className = static_cast<uint16_t>(classes.intern(student.className));
+    records.push_back(record);
+}
+
+Student CompactStudentStore::get(size_t index) const {
+    const Record& record = records[index];
+    if (record.flags & EXCEPTION) {
+        Student student = exceptions.at(static_cast<uint32_t>(index));
+        student.rank = 0;
+        return student;
+    }
+    
+    Student student;
+    student.id.assign(text, record.idOffset, record.idLength);
+    student.name.assign(text, record.nameOffset, record.nameLength);
+    student.gender = (record.genderAge & 0x80) ? 'M' : 'F';
+    student.age = record.genderAge & 0x7F;
+    student.department = departments.name(record.department);
+    student.major = majors.name(record.major);
+    student.className = classes.name(record.className);
+    for (int c = 0; c < 5; c++) {
+        student.*scoreFields[c] = record.scores[c] / 100.0;
+    }
+    student.calculateScores();
+    student.rank = 0;
+    return student;
+}
+
+size_t CompactStudentStore::memoryUsage() const {
+    size_t bytes = MemoryUsage::heapBytes(records) + MemoryUsage::heapBytes(text)
+                 + departments.memoryUsage() + majors.memoryUsage() + classes.memoryUsage()
+                 + MemoryUsage::hashTableBytes(exceptions);
+    for (const auto& entry : exceptions) {
+        const Student& student = entry.second;
+        for (const std::string* field : {&student.id, &student.name, &student.department,
+                                         &student.major, &student.className}) {
+            bytes += MemoryUsage::heapBytes(*field);
+        }
+    }
+    return bytes;
+}
+
+CompactStudentStore::Estimate CompactStudentStore::estimate(const StudentView& students, const InternTable& departments,
+                                                            const InternTable& majors, const InternTable& classes) {
+    Estimate result;
+    bool categoriesFit = departments.size() <= MAX_CATEGORY_ID + 1 && majors.size() <= MAX_CATEGORY_ID + 1
+                      && classes.size() <= MAX_CATEGORY_ID + 1;
+    size_t textBytes = 0;
+    for (const auto& student : students) {
+        size_t length = student.id.size() + student.name.size();
+        if (categoriesFit && fitsRecord(student) && textBytes + length <= MAX_TEXT_BYTES) {
+            textBytes += length;
+        } else {
+            result.exceptions++;
+            result.bytes += exceptionBytes(student);
+        }
+    }
+    result.bytes += students.size() * sizeof(Record) + textBytes
+                  + departments.memoryUsage() + majors.memoryUsage() + classes.memoryUsage();
+    return result;
+}
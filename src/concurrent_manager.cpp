@@ -0,0 +1,664 @@
+#include "concurrent_manager.hpp"
+#include "student_batch.hpp"
+#include "journal.hpp"
+#include "query.hpp"
+#include <algorithm>
+#include <functional>
+#include <unordered_set>
+
+namespace {
+
+// ---------- 读者纪元 ----------
+// 读者取快照前在自己的槽位登记当前纪元，取完清零；写者发布新节点后推进纪元，
+// 旧节点只有在所有槽位都为空闲或已登记更新的纪元后才释放。读路径只有原子读写。
+
+const size_t MAX_READER_SLOTS = 256;
+
+struct alignas(64) ReaderSlot {
+    std::atomic<uint64_t> activeEpoch{0};  // 0 表示不在读
+    std::atomic<bool> claimed{false};
+};
+
+ReaderSlot readerSlots[MAX_READER_SLOTS];
+std::atomic<uint64_t> globalEpoch{1};
+
+// 线程退出时归还槽位
+struct SlotOwner {
+    ReaderSlot* slot = nullptr;
+    ~SlotOwner() {
+        if (slot) slot->claimed.store(false, std::memory_order_release);
+    }
+};
+
+ReaderSlot* localSlot() {
+    thread_local SlotOwner owner;
+    if (!owner.slot) {
+        for (auto& slot : readerSlots) {
+            bool expected = false;
+            if (!slot.claimed.load(std::memory_order_relaxed)
+                && slot.claimed.compare_exchange_strong(expected, true)) {
+                owner.slot = &slot;
+                break;
+            }
+        }
+    }
+    return owner.slot;
+}
+
+// 所有正在读的槽位中最小的纪元；没有读者时为 UINT64_MAX
+uint64_t oldestActiveEpoch() {
+    uint64_t oldest = UINT64_MAX;
+    for (const auto& slot : readerSlots) {
+        uint64_t epoch = slot.activeEpoch.load();
+        if (epoch != 0 && epoch < oldest) oldest = epoch;
+    }
+    return oldest;
+}
+
+} // namespace
+
+// ==================== StudentSnapshot 类实现 ====================
+
+size_t StudentSnapshot::shardOf(const std::string& id) {
+    return std::hash<std::string>{}(id) % ID_SHARDS;
+}
+
+const Student* StudentSnapshot::find(const std::string& id) const {
+    const IdShard& shard = *shards[shardOf(id)];
+    auto found = shard.find(id);
+    return found == shard.end() ? nullptr : &(*this)[found->second];
+}
+
+const std::string& StudentSnapshot::categoryOf(const Student& student, int category) {
+    switch (category) {
+        case DEPARTMENT: return student.department;
+        case MAJOR: return student.major;
+        default: return student.className;
+    }
+}
+
+const StudentSnapshot::Postings* StudentSnapshot::postings(int category, const std::string& value) const {
+    const CategoryMap& map = *categories[category];
+    auto found = map.find(value);
+    return found == map.end() ? nullptr : found->second.get();
+}
+
+int StudentSnapshot::rankOf(const Student& student) const {
+    return ranks->rankOf(student.averageScore) + rankDelta->countAbove(student.averageScore);
+}
+
+// 新增一项时其 above 取自分数更高的下一项，分数更低的各项 above 随之变化
+void StudentSnapshot::RankDelta::add(double averageScore, int delta) {
+    auto it = std::lower_bound(entries.begin(), entries.end(), averageScore,
+                               [](const Entry& entry, double score) { return entry.score < score; });
+    if (it != entries.end() && it->score == averageScore) {
+        it->delta += delta;
+    } else {
+        int above = it == entries.end() ? 0 : it->delta + it->above;
+        it = entries.insert(it, Entry{averageScore, delta, above});
+    }
+    for (auto lower = entries.begin(); lower != it; ++lower) {
+        lower->above += delta;
+    }
+    if (it->delta == 0) {
+        entries.erase(it);
+    }
+}
+
+int StudentSnapshot::RankDelta::countAbove(double averageScore) const {
+    auto it = std::upper_bound(entries.begin(), entries.end(), averageScore,
+                               [](double score, const Entry& entry) { return score < entry.score; });
+    return it == entries.end() ? 0 : it->delta + it->above;
+}
+
+// 与 StudentManager::selectSlots 相同：顶层 AND 中可走索引的等值谓词取最小的候选集，
+// 候选记录再用完整的谓词程序校验；没有可用索引时按存储顺序扫描
+std::vector<const Student*> StudentSnapshot::select(const Query& query) const {
+    CompiledQuery compiled = query.compile();
+    auto accept = [&](const Student& student) {
+        if (!compiled.usesRank()) {
+            return compiled.matches(student);
+        }
+        // 名次谓词需要当前版本的名次
+        Student ranked = student;
+        ranked.rank = rankOf(student);
+        return compiled.matches(ranked);
+    };
+    
+    std::vector<uint32_t> candidates;
+    bool indexed = false;
+    for (const auto& p : compiled.conjuncts()) {
+        if (indexed && candidates.empty()) break;
+        if (p.op != Query::Op::Eq) continue;
+        
+        if (p.field == Query::Field::Id) {
+            const IdShard& shard = *shards[shardOf(p.text)];
+            auto found = shard.find(p.text);
+            candidates.clear();
+            if (found != shard.end()) candidates.push_back(found->second);
+            indexed = true;
+            continue;
+        }
+        
+        int category = p.field == Query::Field::Department ? DEPARTMENT
+                     : p.field == Query::Field::Major ? MAJOR
+                     : p.field == Query::Field::ClassName ? CLASS_NAME : -1;
+        if (category < 0) continue;
+        const Postings* list = postings(category, p.text);
+        size_t size = list ? list->count : 0;
+        if (!indexed || size < candidates.size()) {
+            candidates.clear();
+            if (list) {
+                for (const auto& block : list->blocks) {
+                    candidates.insert(candidates.end(), block->begin(), block->end());
+                }
+            }
+            indexed = true;
+        }
+    }
+    
+    std::vector<const Student*> result;
+    if (indexed) {
+        std::sort(candidates.begin(), candidates.end());
+        for (uint32_t slot : candidates) {
+            const Student& student = (*this)[slot];
+            if (accept(student)) result.push_back(&student);
+        }
+    } else {
+        forEach([&](const Student& student) {
+            if (accept(student)) result.push_back(&student);
+        });
+    }
+    return result;
+}
+
+StudentManager::Statistics StudentSnapshot::getStatistics() const {
+    StudentManager::Statistics stats;
+    stats.totalStudents = count;
+    if (count == 0) {
+        return stats;
+    }
+
+    forEach([&](const Student& student) {
+        stats.avgMath += student.math;
+        stats.avgCpp += student.cpp;
+        stats.avgEnglish += student.english;
+        stats.avgLinearAlgebra += student.linearAlgebra;
+        stats.avgPolitical += student.political;
+        stats.overallAverage += student.averageScore;
+        if (student.averageScore >= 60.0) stats.passCount++;
+    });
+    stats.avgMath /= count;
+    stats.avgCpp /= count;
+    stats.avgEnglish /= count;
+    stats.avgLinearAlgebra /= count;
+    stats.avgPolitical /= count;
+    stats.overallAverage /= count;
+    stats.failCount = stats.totalStudents - stats.passCount;
+    return stats;
+}
+
+// ==================== ConcurrentStudentManager::Draft ====================
+
+// 下一个版本的草稿：从基础快照浅复制，块、分片、分类索引、下标列表块和排名增量在第一次修改时才复制
+class ConcurrentStudentManager::Draft {
+public:
+    Draft(const StudentSnapshot& base)
+        : next(std::make_shared<StudentSnapshot>(base)),
+          ownedChunks(base.chunks.size(), false), ownedShards(StudentSnapshot::ID_SHARDS, false) {
+        next->snapshotVersion = base.snapshotVersion + 1;
+    }
+
+    bool contains(const std::string& id) const {
+        return next->find(id) != nullptr;
+    }
+
+    void add(const Student& student) {
+        uint32_t slot = static_cast<uint32_t>(next->count);
+        if (slot % StudentSnapshot::CHUNK_SIZE == 0) {
+            auto chunk = std::make_shared<Chunk>();
+            chunk->reserve(StudentSnapshot::CHUNK_SIZE);
+            next->chunks.push_back(chunk);
+            auto positions = std::make_shared<Positions>();
+            positions->reserve(StudentSnapshot::CHUNK_SIZE);
+            next->positions.push_back(positions);
+            ownedChunks.push_back(true);
+        }
+        mutableChunk(next->chunks.size() - 1).push_back(student);
+        mutablePositions(next->positions.size() - 1).emplace_back();
+        mutableShard(student.id)[student.id] = slot;
+        for (int c = 0; c < StudentSnapshot::CATEGORY_COUNT; c++) {
+            positionsOf(slot)[c] = list(c, StudentSnapshot::categoryOf(student, c), slot);
+        }
+        addRank(student.averageScore, 1);
+        next->count++;
+    }
+
+    // 与 StudentManager 相同：用末尾记录填补空位，下标列表中按记录的位置直接改写
+    void remove(const std::string& id) {
+        uint32_t slot = next->shards[StudentSnapshot::shardOf(id)]->at(id);
+        addRank(at(slot).averageScore, -1);
+        mutableShard(id).erase(id);
+        for (int c = 0; c < StudentSnapshot::CATEGORY_COUNT; c++) {
+            unlist(c, StudentSnapshot::categoryOf(at(slot), c), slot);
+        }
+
+        uint32_t last = static_cast<uint32_t>(next->count - 1);
+        if (slot != last) {
+            for (int c = 0; c < StudentSnapshot::CATEGORY_COUNT; c++) {
+                uint32_t position = positionsOf(last)[c];
+                Postings& postings = mutablePostings(c, StudentSnapshot::categoryOf(at(last), c));
+                mutableBlock(postings, position / StudentSnapshot::POSTING_BLOCK)[position % StudentSnapshot::POSTING_BLOCK] = slot;
+                positionsOf(slot)[c] = position;
+            }
+            at(slot) = std::move(at(last));
+            mutableShard(at(slot).id)[at(slot).id] = slot;
+        }
+        Chunk& tail = mutableChunk(next->chunks.size() - 1);
+        tail.pop_back();
+        mutablePositions(next->positions.size() - 1).pop_back();
+        if (tail.empty()) {
+            next->chunks.pop_back();
+            next->positions.pop_back();
+            ownedChunks.pop_back();
+        }
+        next->count--;
+    }
+
+    void update(const std::string& id, const Student& newStudent) {
+        uint32_t slot = next->shards[StudentSnapshot::shardOf(id)]->at(id);
+        Student& student = at(slot);
+        addRank(student.averageScore, -1);
+        if (id != newStudent.id) {
+            mutableShard(id).erase(id);
+            mutableShard(newStudent.id)[newStudent.id] = slot;
+        }
+        for (int c = 0; c < StudentSnapshot::CATEGORY_COUNT; c++) {
+            const std::string& value = StudentSnapshot::categoryOf(newStudent, c);
+            if (StudentSnapshot::categoryOf(student, c) != value) {
+                unlist(c, StudentSnapshot::categoryOf(student, c), slot);
+                positionsOf(slot)[c] = list(c, value, slot);
+            }
+        }
+        student = newStudent;
+        student.calculateScores();
+        addRank(student.averageScore, 1);
+    }
+
+    const Student& get(const std::string& id) const {
+        return *next->find(id);
+    }
+
+    std::shared_ptr<const StudentSnapshot> finish() {
+        return std::move(next);
+    }
+
+private:
+    using Chunk = StudentSnapshot::Chunk;
+    using Positions = StudentSnapshot::Positions;
+    using IdShard = StudentSnapshot::IdShard;
+    using Postings = StudentSnapshot::Postings;
+    using Block = StudentSnapshot::Postings::Block;
+    using CategoryMap = StudentSnapshot::CategoryMap;
+    using RankDelta = StudentSnapshot::RankDelta;
+
+    std::shared_ptr<StudentSnapshot> next;
+    std::vector<bool> ownedChunks;  // 本草稿已复制（可写）的块，记录块与位置块一同复制
+    std::vector<bool> ownedShards;
+    bool ownedCategories[StudentSnapshot::CATEGORY_COUNT] = {};
+    std::unordered_set<const Postings*> ownedPostings;
+    std::unordered_set<const Block*> ownedBlocks;
+    bool ownedDelta = false;
+    bool ownedRanks = false;  // 已复制基础索引时直接在其上修改，不再记增量
+
+    // 草稿自己创建的对象本身不是 const，去掉 const 是安全的
+    Chunk& mutableChunk(size_t index) {
+        own(index);
+        return const_cast<Chunk&>(*next->chunks[index]);
+    }
+
+    Positions& mutablePositions(size_t index) {
+        own(index);
+        return const_cast<Positions&>(*next->positions[index]);
+    }
+
+    void own(size_t index) {
+        if (!ownedChunks[index]) {
+            next->chunks[index] = std::make_shared<Chunk>(*next->chunks[index]);
+            next->positions[index] = std::make_shared<Positions>(*next->positions[index]);
+            ownedChunks[index] = true;
+        }
+    }
+
+    IdShard& mutableShard(const std::string& id) {
+        size_t index = StudentSnapshot::shardOf(id);
+        if (!ownedShards[index]) {
+            next->shards[index] = std::make_shared<IdShard>(*next->shards[index]);
+            ownedShards[index] = true;
+        }
+        return const_cast<IdShard&>(*next->shards[index]);
+    }
+
+    CategoryMap& mutableCategory(int category) {
+        if (!ownedCategories[category]) {
+            next->categories[category] = std::make_shared<CategoryMap>(*next->categories[category]);
+            ownedCategories[category] = true;
+        }
+        return const_cast<CategoryMap&>(*next->categories[category]);
+    }
+
+    // 取值对应的下标列表，不存在时新建；复制时只复制块指针，块本身仍共享
+    Postings& mutablePostings(int category, const std::string& value) {
+        std::shared_ptr<const Postings>& postings = mutableCategory(category)[value];
+        if (!postings) {
+            postings = std::make_shared<Postings>();
+            ownedPostings.insert(postings.get());
+        } else if (!ownedPostings.count(postings.get())) {
+            postings = std::make_shared<Postings>(*postings);
+            ownedPostings.insert(postings.get());
+        }
+        return const_cast<Postings&>(*postings);
+    }
+
+    Block& mutableBlock(Postings& postings, size_t index) {
+        std::shared_ptr<const Block>& block = postings.blocks[index];
+        if (!ownedBlocks.count(block.get())) {
+            block = std::make_shared<Block>(*block);
+            ownedBlocks.insert(block.get());
+        }
+        return const_cast<Block&>(*block);
+    }
+
+    // 把 slot 追加到取值的下标列表末尾，返回它在列表中的位置
+    uint32_t list(int category, const std::string& value, uint32_t slot) {
+        Postings& postings = mutablePostings(category, value);
+        if (postings.count % StudentSnapshot::POSTING_BLOCK == 0) {
+            auto block = std::make_shared<Block>();
+            block->reserve(StudentSnapshot::POSTING_BLOCK);
+            postings.blocks.push_back(block);
+            ownedBlocks.insert(block.get());
+        }
+        mutableBlock(postings, postings.blocks.size() - 1).push_back(slot);
+        return static_cast<uint32_t>(postings.count++);
+    }
+
+    // 从取值的下标列表中去掉 slot：列表末尾的下标移到它的位置，只改动两个块；列表为空时删除该取值
+    void unlist(int category, const std::string& value, uint32_t slot) {
+        Postings& postings = mutablePostings(category, value);
+        uint32_t position = positionsOf(slot)[category];
+        uint32_t last = static_cast<uint32_t>(postings.count - 1);
+        if (position != last) {
+            uint32_t moved = postings[last];
+            mutableBlock(postings, position / StudentSnapshot::POSTING_BLOCK)[position % StudentSnapshot::POSTING_BLOCK] = moved;
+            positionsOf(moved)[category] = position;
+        }
+        Block& tail = mutableBlock(postings, postings.blocks.size() - 1);
+        tail.pop_back();
+        if (tail.empty()) {
+            ownedBlocks.erase(&tail);
+            postings.blocks.pop_back();
+        }
+        postings.count--;
+        if (postings.count == 0) {
+            ownedPostings.erase(&postings);
+            mutableCategory(category).erase(value);
+        }
+    }
+
+    // 排名变化先记入增量；增量过大（例如大批量修改）时复制一次基础索引并把增量并入
+    void addRank(double averageScore, int delta) {
+        if (ownedRanks) {
+            applyRank(averageScore, delta);
+            return;
+        }
+        if (!ownedDelta) {
+            next->rankDelta = std::make_shared<RankDelta>(*next->rankDelta);
+            ownedDelta = true;
+        }
+        RankDelta& rankDelta = const_cast<RankDelta&>(*next->rankDelta);
+        rankDelta.add(averageScore, delta);
+        if (rankDelta.entries.size() <= StudentSnapshot::RANK_DELTA_LIMIT) {
+            return;
+        }
+        
+        next->ranks = std::make_shared<RankIndex>(*next->ranks);
+        ownedRanks = true;
+        for (const auto& entry : rankDelta.entries) {
+            applyRank(entry.score, entry.delta);
+        }
+        rankDelta.entries.clear();
+    }
+
+    void applyRank(double averageScore, int delta) {
+        RankIndex& ranks = const_cast<RankIndex&>(*next->ranks);
+        for (; delta > 0; delta--) ranks.insert(averageScore);
+        for (; delta < 0; delta++) ranks.erase(averageScore);
+    }
+
+    Student& at(size_t slot) {
+        return mutableChunk(slot / StudentSnapshot::CHUNK_SIZE)[slot % StudentSnapshot::CHUNK_SIZE];
+    }
+
+    std::array<uint32_t, StudentSnapshot::CATEGORY_COUNT>& positionsOf(size_t slot) {
+        return mutablePositions(slot / StudentSnapshot::CHUNK_SIZE)[slot % StudentSnapshot::CHUNK_SIZE];
+    }
+};
+
+// ==================== ConcurrentStudentManager 类实现 ====================
+
+ConcurrentStudentManager::ConcurrentStudentManager() : current(nullptr) {
+    setStudents({});
+}
+
+ConcurrentStudentManager::~ConcurrentStudentManager() {
+    delete current.load();
+    for (Published* node : retired) {
+        delete node;
+    }
+}
+
+std::shared_ptr<const StudentSnapshot> ConcurrentStudentManager::snapshot() const {
+    ReaderSlot* slot = localSlot();
+    if (!slot) {
+        return std::atomic_load(&latest);
+    }
+    slot->activeEpoch.store(globalEpoch.load());
+    std::shared_ptr<const StudentSnapshot> result = current.load()->snapshot;
+    slot->activeEpoch.store(0, std::memory_order_release);
+    return result;
+}
+
+uint64_t ConcurrentStudentManager::version() const {
+    return snapshot()->version();
+}
+
+// 调用方持有 writeMutex
+void ConcurrentStudentManager::publish(std::shared_ptr<const StudentSnapshot> next) {
+    auto* node = new Published{next};
+    std::atomic_store(&latest, next);
+    Published* old = current.exchange(node);
+    if (old) {
+        old->retiredEpoch = globalEpoch.fetch_add(1) + 1;
+        retired.push_back(old);
+    }
+    reclaim();
+}
+
+// 登记纪元早于节点退休纪元的读者可能仍在读该节点，其余节点可以释放
+void ConcurrentStudentManager::reclaim() {
+    uint64_t oldest = oldestActiveEpoch();
+    size_t kept = 0;
+    for (Published* node : retired) {
+        if (node->retiredEpoch <= oldest) {
+            delete node;
+        } else {
+            retired[kept++] = node;
+        }
+    }
+    retired.resize(kept);
+}
+
+Status ConcurrentStudentManager::addStudent(const Student& student) {
+    std::lock_guard<std::mutex> guard(writeMutex);
+    Draft draft(*current.load()->snapshot);
+    if (draft.contains(student.id)) {
+        return Status::duplicateId(student.id);
+    }
+    draft.add(student);
+    publish(draft.finish());
+
+    if (journal) journal->logAdd(student);
+    return {};
+}
+
+Status ConcurrentStudentManager::deleteStudent(const std::string& id) {
+    std::lock_guard<std::mutex> guard(writeMutex);
+    Draft draft(*current.load()->snapshot);
+    if (!draft.contains(id)) {
+        return Status::notFound(id);
+    }
+    draft.remove(id);
+    publish(draft.finish());
+
+    if (journal) journal->logDelete(id);
+    return {};
+}
+
+Status ConcurrentStudentManager::updateStudent(const std::string& id, const Student& newStudent) {
+    std::lock_guard<std::mutex> guard(writeMutex);
+    Draft draft(*current.load()->snapshot);
+    if (!draft.contains(id)) {
+        return Status::notFound(id);
+    }
+    if (id != newStudent.id && draft.contains(newStudent.id)) {
+        return Status::duplicateId(newStudent.id);
+    }
+    draft.update(id, newStudent);
+    Student logged = draft.get(newStudent.id);
+    publish(draft.finish());
+
+    if (journal) journal->logUpdate(id, logged);
+    return {};
+}
+
+// 在同一份草稿上依次校验并应用，草稿本身就是校验所需的叠加状态
+BatchResult ConcurrentStudentManager::apply(const StudentBatch& batch, bool atomic) {
+    using Operation = StudentBatch::Operation;
+    std::lock_guard<std::mutex> guard(writeMutex);
+    Draft draft(*current.load()->snapshot);
+    BatchResult result;
+    std::vector<const Operation*> applied;
+
+    for (size_t i = 0; i < batch.operations.size(); i++) {
+        const Operation& op = batch.operations[i];
+        Status status = StudentBatch::validate(op, [&](const std::string& id) { return draft.contains(id); });
+        if (status) {
+            if (op.kind == Operation::Add) {
+                draft.add(op.student);
+            } else if (op.kind == Operation::Delete) {
+                draft.remove(op.id);
+            } else {
+                draft.update(op.id, op.student);
+            }
+            applied.push_back(&op);
+        } else {
+            result.errors.push_back({i, std::move(status)});
+        }
+    }
+    if ((atomic && !result.ok()) || applied.empty()) {
+        return result;
+    }
+    publish(draft.finish());
+    result.applied = applied.size();
+
+    if (journal) {
+        for (const Operation* op : applied) {
+            if (op->kind == Operation::Add) {
+                journal->logAdd(op->student);
+            } else if (op->kind == Operation::Delete) {
+                journal->logDelete(op->id);
+            } else {
+                Student logged = op->student;
+                logged.calculateScores();
+                journal->logUpdate(op->id, logged);
+            }
+        }
+        journal->sync();
+    }
+    return result;
+}
+
+// 整体替换：直接按块构建新版本，学号重复时保留第一条
+void ConcurrentStudentManager::setStudents(const std::vector<Student>& students) {
+    auto next = std::make_shared<StudentSnapshot>();
+    std::vector<std::shared_ptr<StudentSnapshot::IdShard>> shards(StudentSnapshot::ID_SHARDS);
+    for (auto& shard : shards) {
+        shard = std::make_shared<StudentSnapshot::IdShard>();
+    }
+
+    std::shared_ptr<StudentSnapshot::Chunk> chunk;
+    std::shared_ptr<StudentSnapshot::Positions> positions;
+    std::unordered_map<std::string, std::vector<uint32_t>> postings[StudentSnapshot::CATEGORY_COUNT];
+    std::vector<double> averages;
+    averages.reserve(students.size());
+    for (const auto& student : students) {
+        if (!shards[StudentSnapshot::shardOf(student.id)]->emplace(student.id, next->count).second) {
+            continue;
+        }
+        if (next->count % StudentSnapshot::CHUNK_SIZE == 0) {
+            chunk = std::make_shared<StudentSnapshot::Chunk>();
+            chunk->reserve(StudentSnapshot::CHUNK_SIZE);
+            next->chunks.push_back(chunk);
+            positions = std::make_shared<StudentSnapshot::Positions>();
+            positions->reserve(StudentSnapshot::CHUNK_SIZE);
+            next->positions.push_back(positions);
+        }
+        chunk->push_back(student);
+        positions->emplace_back();
+        for (int c = 0; c < StudentSnapshot::CATEGORY_COUNT; c++) {
+            std::vector<uint32_t>& list = postings[c][StudentSnapshot::categoryOf(student, c)];
+            positions->back()[c] = static_cast<uint32_t>(list.size());
+            list.push_back(static_cast<uint32_t>(next->count));
+        }
+        averages.push_back(student.averageScore);
+        next->count++;
+    }
+    next->shards.assign(shards.begin(), shards.end());
+    for (int c = 0; c < StudentSnapshot::CATEGORY_COUNT; c++) {
+        auto map = std::make_shared<StudentSnapshot::CategoryMap>();
+        for (const auto& entry : postings[c]) {
+            auto list = std::make_shared<StudentSnapshot::Postings>();
+            list->count = entry.second.size();
+            for (size_t i = 0; i < entry.second.size(); i += StudentSnapshot::POSTING_BLOCK) {
+                size_t end = std::min(entry.second.size(), i + StudentSnapshot::POSTING_BLOCK);
+                auto block = std::make_shared<StudentSnapshot::Postings::Block>(entry.second.begin() + i,
+                                                                                 entry.second.begin() + end);
+                list->blocks.push_back(block);
+            }
+            map->emplace(entry.first, list);
+        }
+        next->categories[c] = map;
+    }
+
+    auto ranks = std::make_shared<RankIndex>();
+    ranks->build(averages.data(), averages.size());
+    next->ranks = ranks;
+    next->rankDelta = std::make_shared<StudentSnapshot::RankDelta>();
+
+    std::lock_guard<std::mutex> guard(writeMutex);
+    Published* node = current.load();
+    next->snapshotVersion = node ? node->snapshot->version() + 1 : 1;
+    publish(next);
+
+    // 只记录实际发布的记录，被跳过的重复学号不进日志，否则重放时会当作失败的添加
+    if (journal) {
+        journal->logClear();
+        next->forEach([this](const Student& student) { journal->logAdd(student); });
+        journal->sync();
+    }
+}
+
+void ConcurrentStudentManager::setJournal(Journal* newJournal) {
+    std::lock_guard<std::mutex> guard(writeMutex);
+    journal = newJournal;
+}
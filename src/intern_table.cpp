@@ -0,0 +1,48 @@
+#include "intern_table.hpp"
+#include "memory_usage.hpp"
+#include <algorithm>
+
+// ==================== InternTable 类实现 ====================
+
+void InternTable::clear() {
+    ids.clear();
+    names.clear();
+}
+
+uint32_t InternTable::intern(std::string_view value) {
+    auto found = ids.find(value);
+    if (found != ids.end()) {
+        return found->second;
+    }
+    
+    uint32_t id = static_cast<uint32_t>(names.size());
+    names.emplace_back(value);
+    ids.emplace(names.back(), id);
+    return id;
+}
+
+uint32_t InternTable::find(std::string_view value) const {
+    auto found = ids.find(value);
+    return found == ids.end() ? NONE : found->second;
+}
+
+size_t InternTable::memoryUsage() const {
+    size_t bytes = MemoryUsage::hashTableBytes(ids) + names.size() * sizeof(std::string);
+    for (const auto& name : names) bytes += MemoryUsage::heapBytes(name);
+    return bytes;
+}
+
+std::vector<uint32_t> InternTable::sortedOrder() const {
+    std::vector<uint32_t> byName(names.size());
+    for (uint32_t id = 0; id < byName.size(); id++) {
+        byName[id] = id;
+    }
+    std::sort(byName.begin(), byName.end(),
+        [this](uint32_t a, uint32_t b) { return names[a] < names[b]; });
+    
+    std::vector<uint32_t> order(names.size());
+    for (uint32_t i = 0; i < byName.size(); i++) {
+        order[byName[i]] = i;
+    }
+    return order;
+}
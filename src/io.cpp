@@ -1,17 +1,11 @@
 #include "io.hpp"
 #include <iostream>
-#include <fstream>
 #include <string>
 #include <vector>
 #include <limits>
-#include <filesystem>
 #include <iomanip>
-#include <sstream>
-#include <chrono>
-#include <ctime>
 #include <algorithm>
-
-namespace fs = std::filesystem;
+#include <charconv>
 
 // ==================== InputHelper 类实现 ====================
 
@@ -89,207 +83,110 @@ bool InputHelper::confirm(const std::string& message) {
     return toupper(choice) == 'Y';
 }
 
-// ==================== FileStorage 类实现 ====================
+// ==================== StudentPager 类实现 ====================
 
-FileStorage::FileStorage() : dataDir("data"), dataFile("data/students.txt") {
-    ensureDataDirectory();
-}
+namespace {
 
-void FileStorage::ensureDataDirectory() {
-    if (!fs::exists(dataDir)) {
-        fs::create_directory(dataDir);
+// 左对齐写入定宽列；超过 maxLength 时截断并加 "..."（与原 setw 输出一致）
+void appendCell(std::string& out, std::string_view text, size_t width, size_t maxLength = std::string::npos) {
+    size_t start = out.size();
+    if (text.size() > maxLength) {
+        out.append(text.data(), maxLength - 1);
+        out += "...";
+    } else {
+        out.append(text.data(), text.size());
+    }
+    size_t written = out.size() - start;
+    if (written < width) {
+        out.append(width - written, ' ');
     }
 }
 
-void FileStorage::setDataFile(const std::string& path) {
-    dataFile = path;
-    dataDir = fs::path(path).parent_path().string();
-    ensureDataDirectory();
+void appendTableRow(std::string& out, const Student& student) {
+    char number[32];
+    appendCell(out, student.id, 12, 11);
+    appendCell(out, student.name, 10, 9);
+    appendCell(out, student.gender == 'M' ? "M" : "F", 6);
+    auto end = std::to_chars(number, number + sizeof(number), student.age).ptr;
+    appendCell(out, std::string_view(number, end - number), 6);
+    appendCell(out, student.major, 15, 14);
+    end = std::to_chars(number, number + sizeof(number), student.averageScore,
+                        std::chars_format::fixed, 1).ptr;
+    appendCell(out, std::string_view(number, end - number), 8);
+    end = std::to_chars(number, number + sizeof(number), student.rank).ptr;
+    appendCell(out, std::string_view(number, end - number), 6);
+    out += '\n';
 }
 
-bool FileStorage::saveStudents(const std::vector<Student>& students) {
-    std::ofstream file(dataFile);
-    if (!file.is_open()) {
-        std::cerr << "Error: Cannot open file " << dataFile << " for writing!\n";
-        return false;
-    }
-    
-    // 写入数据头
-    file << "# Student Management System Data File\n";
-    file << "# Format: id|name|gender|age|department|major|class|math|cpp|english|linearAlgebra|political|totalScore|averageScore|rank\n";
-    
-    // 写入每个学生的数据
-    for (const auto& student : students) {
-        file << student.toString() << "\n";
-    }
-    
-    file.close();
-    std::cout << "Data saved to " << dataFile << " (" << students.size() << " records)\n";
-    return true;
+const char TABLE_HEADER[] =
+    "Student ID  Name      GenderAge   Major          Average Rank  \n";
+
+} // namespace
+
+StudentPager::StudentPager(const StudentView& students, size_t pageSize)
+    : students(students), pageSize(pageSize > 0 ? pageSize : DEFAULT_PAGE_SIZE), page(0) {}
+
+size_t StudentPager::pageCount() const {
+    return (students.size() + pageSize - 1) / pageSize;
 }
 
-std::vector<Student> FileStorage::loadStudents() {
-    std::vector<Student> students;
-    
-    std::ifstream file(dataFile);
-    if (!file.is_open()) {
-        std::cout << "Data file not found, will create a new one.\n";
-        return students;
-    }
-    
-    std::string line;
-    int lineCount = 0;
-    
-    while (std::getline(file, line)) {
-        lineCount++;
-        
-        // 跳过空行和注释行
-        if (line.empty() || line[0] == '#') {
-            continue;
-        }
-        
-        try {
-            Student student = Student::fromString(line);
-            students.push_back(student);
-        } catch (const std::exception& e) {
-            std::cerr << "Warning: Line " << lineCount << " has invalid format: " << e.what() << "\n";
-        }
-    }
-    
-    file.close();
-    std::cout << "Loaded " << students.size() << " student records from " << dataFile << "\n";
-    return students;
+size_t StudentPager::currentPage() const {
+    return page;
 }
 
-bool FileStorage::createBackup() {
-    if (!fs::exists(dataFile)) {
-        std::cout << "No data to backup\n";
-        return false;
-    }
-    
-    // 生成备份文件名（包含时间戳）
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-    std::tm tm = *std::localtime(&time);
-    
-    std::ostringstream oss;
-    oss << "data/backup_students_"
-        << (tm.tm_year + 1900) << "-"
-        << std::setfill('0') << std::setw(2) << (tm.tm_mon + 1) << "-"
-        << std::setw(2) << tm.tm_mday << "_"
-        << std::setw(2) << tm.tm_hour << "-"
-        << std::setw(2) << tm.tm_min << ".txt";
-    
-    std::string backupFile = oss.str();
-    
-    try {
-        fs::copy_file(dataFile, backupFile, fs::copy_options::overwrite_existing);
-        std::cout << "Data backed up to " << backupFile << "\n";
-        return true;
-    } catch (const fs::filesystem_error& e) {
-        std::cerr << "Backup failed: " << e.what() << "\n";
-        return false;
-    }
+bool StudentPager::next() {
+    return jump(page + 1);
+}
+
+bool StudentPager::prev() {
+    return page > 0 && jump(page - 1);
 }
 
-bool FileStorage::exportToCSV(const std::vector<Student>& students, const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Cannot create file " << filename << "\n";
+bool StudentPager::jump(size_t newPage) {
+    if (newPage >= pageCount()) {
         return false;
     }
-    
-    // CSV头部
-    file << "StudentID,Name,Gender,Age,Department,Major,Class,Math,C++,English,LinearAlgebra,Political,TotalScore,AverageScore,Rank\n";
-    
-    // 数据行
-    for (const auto& student : students) {
-        file << student.id << ","
-             << student.name << ","
-             << student.gender << ","
-             << student.age << ","
-             << student.department << ","
-             << student.major << ","
-             << student.className << ","
-             << student.math << ","
-             << student.cpp << ","
-             << student.english << ","
-             << student.linearAlgebra << ","
-             << student.political << ","
-             << student.totalScore << ","
-             << student.averageScore << ","
-             << student.rank << "\n";
-    }
-    
-    file.close();
-    std::cout << "Data exported to " << filename << " (" << students.size() << " records)\n";
+    page = newPage;
     return true;
 }
 
-std::vector<Student> FileStorage::importFromCSV(const std::string& filename) {
-    std::vector<Student> students;
+void StudentPager::render(std::string& out) const {
+    size_t first = page * pageSize;
+    size_t last = std::min(first + pageSize, students.size());
     
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Cannot open file " << filename << "\n";
-        return students;
-    }
-    
-    std::string line;
-    int lineCount = 0;
+    out += "\n========== Student List ==========\n";
+    out += "Showing ";
+    out += std::to_string(first + 1);
+    out += '-';
+    out += std::to_string(last);
+    out += " / ";
+    out += std::to_string(students.size());
+    out += " records (page ";
+    out += std::to_string(page + 1);
+    out += " of ";
+    out += std::to_string(pageCount());
+    out += ")\n\n";
+    out += TABLE_HEADER;
+    out.append(65, '-');
+    out += '\n';
     
-    while (std::getline(file, line)) {
-        lineCount++;
-        
-        // 跳过空行和标题行
-        if (line.empty() || lineCount == 1) {
-            continue;
-        }
-        
-        try {
-            // CSV解析
-            std::istringstream iss(line);
-            std::vector<std::string> tokens;
-            std::string token;
-            
-            while (std::getline(iss, token, ',')) {
-                tokens.push_back(token);
-            }
-            
-            if (tokens.size() >= 15) {
-                Student student;
-                student.id = tokens[0];
-                student.name = tokens[1];
-                student.gender = tokens[2][0];
-                student.age = std::stoi(tokens[3]);
-                student.department = tokens[4];
-                student.major = tokens[5];
-                student.className = tokens[6];
-                student.math = std::stod(tokens[7]);
-                student.cpp = std::stod(tokens[8]);
-                student.english = std::stod(tokens[9]);
-                student.linearAlgebra = std::stod(tokens[10]);
-                student.political = std::stod(tokens[11]);
-                student.totalScore = std::stod(tokens[12]);
-                student.averageScore = std::stod(tokens[13]);
-                student.rank = std::stoi(tokens[14]);
-                student.calculateScores();
-                
-                students.push_back(student);
-            }
-        } catch (const std::exception& e) {
-            std::cerr << "Warning: Line " << lineCount << " import failed: " << e.what() << "\n";
-        }
+    for (size_t i = first; i < last; i++) {
+        appendTableRow(out, students[i]);
     }
-    
-    file.close();
-    std::cout << "Imported " << students.size() << " student records from " << filename << "\n";
-    return students;
 }
 
 // ==================== DisplayHelper 类实现 ====================
 
+namespace {
+bool interactive = true;
+}
+
+void DisplayHelper::setInteractive(bool enabled) {
+    interactive = enabled;
+}
+
 void DisplayHelper::clearScreen() {
+    if (!interactive) return;
 #ifdef _WIN32
     system("cls");""
 #else
@@ -297,51 +194,100 @@ void DisplayHelper::clearScreen() {
 #endif
 }
 
-void DisplayHelper::displayStudentTable(const std::vector<Student>& students, bool showAll) {
+void DisplayHelper::displayStudentTable(const StudentView& students, bool showAll) {
     if (students.empty()) {
         std::cout << "\nNo student records found.\n";
         return;
     }
-    
-    // 限制显示数量
-    size_t displayCount = showAll ? students.size() : std::min(students.size(), size_t(20));
-    
-    std::cout << "\n========== Student List ==========\n";
-    std::cout << "Showing " << displayCount << " / " << students.size() << " records\n\n";
-    
-    // 表头
-    std::cout << std::left 
-              << std::setw(12) << "Student ID"
-              << std::setw(10) << "Name"
-              << std::setw(6) << "Gender"
-              << std::setw(6) << "Age"
-              << std::setw(15) << "Major"
-              << std::setw(8) << "Average"
-              << std::setw(6) << "Rank"
-              << "\n";
-    
-    std::cout << std::string(65, '-') << "\n";
-    
-    // 表格内容
-    for (size_t i = 0; i < displayCount; i++) {
-        const auto& student = students[i];
-        std::cout << std::left 
-                  << std::setw(12) << (student.id.length() > 11 ? student.id.substr(0, 10) + "..." : student.id)
-                  << std::setw(10) << (student.name.length() > 9 ? student.name.substr(0, 8) + "..." : student.name)
-                  << std::setw(6) << (student.gender == 'M' ? "M" : "F")
-                  << std::setw(6) << student.age
-                  << std::setw(15) << (student.major.length() > 14 ? student.major.substr(0, 13) + "..." : student.major)
-                  << std::setw(8) << std::fixed << std::setprecision(1) << student.averageScore
-                  << std::setw(6) << student.rank
-                  << "\n";
+    if (showAll && students.size() > StudentPager::DEFAULT_PAGE_SIZE && interactive) {
+        browseStudentTable(students);
+        return;
     }
     
-    if (!showAll && students.size() > 20) {
-        std::cout << "\n... " << (students.size() - 20) << " more records not shown\n";
-        std::cout << "Enter 'all' to show all records\n";
+    StudentPager pager(students, showAll ? students.size() : StudentPager::DEFAULT_PAGE_SIZE);
+    std::string out;
+    pager.render(out);
+    if (!showAll && students.size() > StudentPager::DEFAULT_PAGE_SIZE) {
+        out += "\n... ";
+        out += std::to_string(students.size() - StudentPager::DEFAULT_PAGE_SIZE);
+        out += " more records not shown\n";
     }
+    out += "===============================\n";
+    std::cout.write(out.data(), out.size());
+}
+
+// 交互式分页：n 下一页，p 上一页，数字跳页，q 退出
+void DisplayHelper::browseStudentTable(const StudentView& students) {
+    StudentPager pager(students);
+    std::string out;
+    std::string input;
     
-    std::cout << "===============================\n";
+    while (true) {
+        out.clear();
+        pager.render(out);
+        out += "===============================\n";
+        out += "[n]ext  [p]rev  [page number]  [q]uit: ";
+        std::cout.write(out.data(), out.size());
+        std::cout.flush();
+        
+        if (!std::getline(std::cin, input)) {
+            std::cin.clear();
+            break;
+        }
+        input.erase(0, input.find_first_not_of(" \t\r"));
+        input.erase(input.find_last_not_of(" \t\r") + 1);
+        
+        if (input.empty() || input == "n") {
+            if (!pager.next()) break;  // 最后一页再按回车即退出
+        } else if (input == "p") {
+            pager.prev();
+        } else if (input == "q") {
+            break;
+        } else {
+            size_t target = 0;
+            auto parsed = std::from_chars(input.data(), input.data() + input.size(), target);
+            if (parsed.ec != std::errc() || parsed.ptr != input.data() + input.size() ||
+                !pager.jump(target - 1)) {
+                std::cout << "Invalid page, enter 1-" << pager.pageCount() << "\n";
+            }
+        }
+    }
+    std::cout << "\n";
+}
+
+void DisplayHelper::displayStudent(const Student& student) {
+    std::cout << "\n========== Student Information ==========\n";
+    std::cout << "Student ID: " << student.id << "\n";
+    std::cout << "Name: " << student.name << "\n";
+    std::cout << "Gender: " << (student.gender == 'M' ? "Male" : "Female") << "\n";
+    std::cout << "Age: " << student.age << "\n";
+    std::cout << "Department: " << student.department << "\n";
+    std::cout << "Major: " << student.major << "\n";
+    std::cout << "Class: " << student.className << "\n";
+    std::cout << "\n-------- Course Scores --------\n";
+    std::cout << "Advanced Math: " << student.math << "\n";
+    std::cout << "C++ Programming: " << student.cpp << "\n";
+    std::cout << "English: " << student.english << "\n";
+    std::cout << "Linear Algebra: " << student.linearAlgebra << "\n";
+    std::cout << "Political: " << student.political << "\n";
+    std::cout << "\n-------- Statistics --------\n";
+    std::cout << "Total Score: " << student.totalScore << "\n";
+    std::cout << "Average Score: " << student.averageScore << "\n";
+    std::cout << "Rank: " << student.rank << "\n";
+    std::cout << "=======================================\n";
+}
+
+void DisplayHelper::displayFailingStudents(const StudentView& students) {
+    std::cout << "\n========== Failing Students ==========\n";
+    for (const auto& student : students) {
+        std::cout << "ID: " << student.id 
+                 << ", Name: " << student.name
+                 << ", Average: " << student.averageScore << "\n";
+    }
+    if (students.empty()) {
+        std::cout << "All students have passed!\n";
+    }
+    std::cout << "====================================\n";
 }
 
 void DisplayHelper::displayStatistics(const StudentManager::Statistics& stats) {
@@ -363,6 +309,76 @@ void DisplayHelper::displayStatistics(const StudentManager::Statistics& stats) {
     std::cout << "===============================\n";
 }
 
+void DisplayHelper::displayGroupedStatistics(const std::string& title,
+                                             const std::vector<StudentManager::GroupStatistics>& groups) {
+    std::cout << "\n========== Statistics by " << title << " ==========\n";
+    if (groups.empty()) {
+        std::cout << "No student records found.\n";
+        std::cout << "===============================\n";
+        return;
+    }
+    
+    std::cout << std::left
+              << std::setw(16) << title
+              << std::setw(7) << "Count"
+              << std::setw(8) << "Pass%"
+              << std::setw(8) << "Math"
+              << std::setw(8) << "C++"
+              << std::setw(8) << "English"
+              << std::setw(8) << "LinAlg"
+              << std::setw(8) << "Politic"
+              << std::setw(8) << "Average"
+              << "\n";
+    std::cout << std::string(79, '-') << "\n";
+    
+    for (const auto& group : groups) {
+        const auto& stats = group.stats;
+        std::cout << std::left
+                  << std::setw(16) << (group.key.length() > 15 ? group.key.substr(0, 12) + "..." : group.key)
+                  << std::setw(7) << stats.totalStudents
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(8) << (stats.totalStudents > 0 ? stats.passCount * 100.0 / stats.totalStudents : 0)
+                  << std::setprecision(2)
+                  << std::setw(8) << stats.avgMath
+                  << std::setw(8) << stats.avgCpp
+                  << std::setw(8) << stats.avgEnglish
+                  << std::setw(8) << stats.avgLinearAlgebra
+                  << std::setw(8) << stats.avgPolitical
+                  << std::setw(8) << stats.overallAverage
+                  << "\n";
+    }
+    std::cout << "===============================\n";
+}
+
+void DisplayHelper::displayMemoryReport(const StudentManager::MemoryReport& report) {
+    auto megabytes = [](size_t bytes) { return bytes / (1024.0 * 1024.0); };
+    auto perRecord = [&report](size_t bytes) {
+        return report.records > 0 ? static_cast<double>(bytes) / report.records : 0.0;
+    };
+    size_t total = report.recordBytes + report.stringHeapBytes + report.indexBytes;
+    
+    std::cout << "\n========== Memory Report ==========\n";
+    std::cout << "Records: " << report.records << "\n\n";
+    std::cout << std::left << std::setw(22) << "Component" << std::right
+              << std::setw(12) << "MiB" << std::setw(16) << "Bytes/record" << "\n";
+    std::cout << std::string(50, '-') << "\n";
+    
+    auto row = [&](const char* name, size_t bytes) {
+        std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << megabytes(bytes) << std::setw(16) << perRecord(bytes) << "\n";
+    };
+    row("Student records", report.recordBytes);
+    row("String heap", report.stringHeapBytes);
+    row("Indexes and columns", report.indexBytes);
+    row("Total", total);
+    std::cout << std::string(50, '-') << "\n";
+    row("Compact (estimate)", report.compactEstimateBytes);
+    if (report.compactEstimateExceptions > 0) {
+        std::cout << "  (" << report.compactEstimateExceptions << " records would stay uncompressed)\n";
+    }
+    std::cout << "===================================\n";
+}
+
 void DisplayHelper::displayMenu() {
     clearScreen();
     std::cout << "========================================\n";
@@ -380,6 +396,9 @@ void DisplayHelper::displayMenu() {
     std::cout << "10. Import/Export Data\n";
     std::cout << "11. Save Data\n";
     std::cout << "12. Reload Data\n";
+    std::cout << "13. Grouped Statistics\n";
+    std::cout << "14. Top / Bottom Students\n";
+    std::cout << "15. Memory Report\n";
     std::cout << "0. Exit\n";
     std::cout << "========================================\n";
 }
@@ -401,6 +420,7 @@ void DisplayHelper::showWelcome() {
 }
 
 void DisplayHelper::pause() {
+    if (!interactive) return;
     std::cout << "\nPress Enter to continue...";
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     std::cin.get();
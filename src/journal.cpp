@@ -0,0 +1,257 @@
+#include "journal.hpp"
+#include "student.hpp"
+#include "student_batch.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const size_t DEFAULT_BATCH_SIZE = 32;
+const size_t DEFAULT_COMPACT_THRESHOLD = 10000;
+const auto MAX_SYNC_DELAY = std::chrono::seconds(1);
+
+// FNV-1a，用于识别崩溃时写了一半的记录
+uint32_t checksum(const char* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+Journal::Journal()
+    : writer(64 << 10), opened(false), sequence(0), unsynced(0), recordCount(0),
+      batchSize(DEFAULT_BATCH_SIZE), compactThreshold(DEFAULT_COMPACT_THRESHOLD) {}
+
+Journal::~Journal() {
+    close();
+}
+
+// 打开日志并扫描已有记录，使新记录的序号接续下去
+// 日志被快照截断后为空，此时序号从快照记录的 baseSequence 接续，否则新记录会被当作已落盘而跳过
+bool Journal::open(const std::string& journalPath, uint64_t baseSequence) {
+    close();
+    path = journalPath;
+    
+    std::vector<std::string> records;
+    std::vector<uint64_t> sequences;
+    size_t validBytes = 0;
+    if (readRecords(records, sequences, &validBytes)) {
+        // 截掉崩溃留下的残缺尾部，否则之后追加的记录会排在损坏记录之后而无法重放
+        std::error_code ec;
+        if (std::filesystem::file_size(path, ec) > validBytes && !ec) {
+            std::filesystem::resize_file(path, validBytes, ec);
+        }
+    }
+    sequence = std::max(baseSequence, sequences.empty() ? uint64_t(0) : sequences.back());
+    recordCount = records.size();
+    
+    if (!writer.open(path, true)) {
+        std::cerr << "Error: Cannot open journal " << path << "\n";
+        return false;
+    }
+    opened = true;
+    unsynced = 0;
+    lastSync = std::chrono::steady_clock::now();
+    return true;
+}
+
+void Journal::close() {
+    if (opened) {
+        sync();
+        writer.close();
+        opened = false;
+    }
+}
+
+void Journal::append(char op, const std::string& payload) {
+    if (!opened) return;
+    
+    line.clear();
+    line += std::to_string(++sequence);
+    line += '|';
+    line += op;
+    line += '|';
+    line += payload;
+    
+    char prefix[16];
+    std::snprintf(prefix, sizeof(prefix), "%08x ", checksum(line.data(), line.size()));
+    writer.buffer() += prefix;
+    writer.buffer() += line;
+    writer.buffer() += '\n';
+    
+    // 每条记录返回前即写入操作系统，进程崩溃不会丢失；只有 fsync 按批次进行
+    writer.commit();
+    recordCount++;
+    unsynced++;
+    if (unsynced >= batchSize || std::chrono::steady_clock::now() - lastSync >= MAX_SYNC_DELAY) {
+        sync();
+    }
+}
+
+void Journal::logAdd(const Student& student) {
+    append('A', student.toString());
+}
+
+void Journal::logDelete(const std::string& id) {
+    append('D', id);
+}
+
+void Journal::logUpdate(const std::string& oldId, const Student& student) {
+    append('U', oldId + "|" + student.toString());
+}
+
+void Journal::logClear() {
+    append('C', "");
+}
+
+bool Journal::sync() {
+    if (!opened) return false;
+    
+    unsynced = 0;
+    lastSync = std::chrono::steady_clock::now();
+    if (!writer.sync()) {
+        std::cerr << "Error: Failed to sync journal " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool Journal::truncate() {
+    if (!opened) return false;
+    
+    writer.close();
+    if (!writer.open(path) || !writer.sync()) {
+        std::cerr << "Error: Cannot truncate journal " << path << "\n";
+        opened = false;
+        return false;
+    }
+    recordCount = 0;
+    unsynced = 0;
+    return true;
+}
+
+bool Journal::needsCompaction() const {
+    return opened && recordCount >= compactThreshold;
+}
+
+// 读取所有完整且校验通过的记录，遇到损坏的记录即停止（其后内容视为未提交）
+bool Journal::readRecords(std::vector<std::string>& records, std::vector<uint64_t>& sequences,
+                          size_t* validBytes, bool quiet) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    size_t pos = 0;
+    int lineNumber = 0;
+    if (validBytes) *validBytes = 0;
+    
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        lineNumber++;
+        if (end == std::string::npos) {
+            if (!quiet) std::cerr << "Warning: Journal " << path << " ends with an incomplete record, ignored\n";
+            break;
+        }
+        
+        std::string record = text.substr(pos, end - pos);
+        pos = end + 1;
+        
+        unsigned int expected = 0;
+        bool valid = record.size() > 9 && record[8] == ' '
+                  && std::sscanf(record.c_str(), "%8x", &expected) == 1
+                  && checksum(record.data() + 9, record.size() - 9) == expected;
+        if (!valid) {
+            if (!quiet) {
+                std::cerr << "Warning: Journal " << path << " line " << lineNumber
+                          << " is corrupted, ignoring the rest\n";
+            }
+            break;
+        }
+        
+        record.erase(0, 9);
+        sequences.push_back(std::stoull(record));
+        records.push_back(std::move(record));
+        if (validBytes) *validBytes = pos;
+    }
+    return true;
+}
+
+size_t Journal::replay(StudentManager& manager, uint64_t afterSequence) {
+    std::vector<std::string> records;
+    std::vector<uint64_t> sequences;
+    if (!readRecords(records, sequences, nullptr, true)) {
+        return 0;
+    }
+    
+    // 连续的增删改攒成一批应用，只在清空记录处分批
+    StudentBatch batch;
+    std::vector<uint64_t> batchSequences;
+    auto flush = [&]() {
+        BatchResult result = manager.apply(batch, false);
+        for (const auto& error : result.errors) {
+            std::cerr << "Warning: Journal record " << batchSequences[error.index]
+                      << " skipped: " << error.status.message << "\n";
+        }
+        batch.clear();
+        batchSequences.clear();
+        return result.applied;
+    };
+    
+    size_t applied = 0;
+    for (size_t i = 0; i < records.size(); i++) {
+        if (sequences[i] <= afterSequence) {
+            continue;
+        }
+        
+        // 记录格式：<序号>|<操作>|<内容>
+        const std::string& record = records[i];
+        size_t opPos = record.find('|');
+        if (opPos == std::string::npos || opPos + 1 >= record.size()) {
+            continue;
+        }
+        char op = record[opPos + 1];
+        std::string payload = record.substr(std::min(opPos + 3, record.size()));
+        
+        try {
+            switch (op) {
+                case 'A':
+                    batch.add(Student::fromString(payload));
+                    break;
+                case 'D':
+                    batch.remove(payload);
+                    break;
+                case 'U': {
+                    size_t sep = payload.find('|');
+                    batch.update(payload.substr(0, sep), Student::fromString(payload.substr(sep + 1)));
+                    break;
+                }
+                case 'C':
+                    applied += flush();
+                    manager.clear();
+                    applied++;
+                    continue;
+                default:
+                    continue;
+            }
+            batchSequences.push_back(sequences[i]);
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: Journal record " << sequences[i] << " skipped: " << e.what() << "\n";
+        }
+    }
+    applied += flush();
+    
+    if (!sequences.empty() && sequences.back() > sequence) {
+        sequence = sequences.back();
+    }
+    return applied;
+}
@@ -0,0 +1,461 @@
+#include "query.hpp"
+#include "student.hpp"
+#include "secondary_index.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+// ==================== Query 类实现 ====================
+
+Query::Query() {}
+
+Query Query::compare(Field field, Op op, double value) {
+    Query query;
+    auto node = std::make_shared<Node>();
+    node->predicate.field = field;
+    node->predicate.op = op;
+    node->predicate.low = value;
+    node->predicate.high = value;
+    query.root = node;
+    return query;
+}
+
+Query Query::compare(Field field, Op op, const std::string& value) {
+    Query query;
+    auto node = std::make_shared<Node>();
+    node->predicate.field = field;
+    node->predicate.op = op;
+    node->predicate.text = value;
+    node->predicate.textHigh = value;
+    query.root = node;
+    return query;
+}
+
+Query Query::between(Field field, double low, double high) {
+    Query query = compare(field, Op::Between, low);
+    std::const_pointer_cast<Node>(query.root)->predicate.high = high;
+    return query;
+}
+
+Query Query::contains(Field field, const std::string& text) {
+    return compare(field, Op::Contains, text);
+}
+
+Query Query::combine(Node::Kind kind, const Query& a, const Query& b) {
+    if (!a.root) return b;
+    if (!b.root) return a;
+    
+    Query query;
+    auto node = std::make_shared<Node>();
+    node->kind = kind;
+    node->children = {a.root, b.root};
+    query.root = node;
+    return query;
+}
+
+Query operator&&(const Query& a, const Query& b) {
+    return Query::combine(Query::Node::And, a, b);
+}
+
+Query operator||(const Query& a, const Query& b) {
+    return Query::combine(Query::Node::Or, a, b);
+}
+
+Query operator!(const Query& q) {
+    if (!q.root) return q;
+    
+    Query query;
+    auto node = std::make_shared<Query::Node>();
+    node->kind = Query::Node::Not;
+    node->children = {q.root};
+    query.root = node;
+    return query;
+}
+
+bool Query::fieldFromName(const std::string& name, Field& field) {
+    std::string key = name;
+    std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return std::tolower(c); });
+    
+    static const std::pair<const char*, Field> names[] = {
+        {"id", Field::Id}, {"name", Field::Name}, {"gender", Field::Gender}, {"age", Field::Age},
+        {"department", Field::Department}, {"dept", Field::Department}, {"major", Field::Major},
+        {"class", Field::ClassName}, {"math", Field::Math}, {"cpp", Field::Cpp},
+        {"english", Field::English}, {"linearalgebra", Field::LinearAlgebra},
+        {"political", Field::Political}, {"total", Field::Total}, {"average", Field::Average},
+        {"rank", Field::Rank}
+    };
+    for (const auto& entry : names) {
+        if (key == entry.first) {
+            field = entry.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Query::isNumeric(Field field) {
+    switch (field) {
+        case Field::Id: case Field::Name: case Field::Gender:
+        case Field::Department: case Field::Major: case Field::ClassName:
+            return false;
+        default:
+            return true;
+    }
+}
+
+// 编译为后缀形式：子节点在前，运算在后
+void Query::emit(const Node& node, CompiledQuery& compiled) {
+    if (node.kind == Node::Test) {
+        compiled.program.push_back({CompiledQuery::Instruction::Test, node.predicate, nullptr, 0});
+        if (node.predicate.field == Field::Rank) compiled.rankUsed = true;
+        return;
+    }
+    
+    emit(*node.children[0], compiled);
+    if (node.kind == Node::Not) {
+        compiled.program.push_back({CompiledQuery::Instruction::Not, {}, nullptr, 0});
+        return;
+    }
+    emit(*node.children[1], compiled);
+    compiled.program.push_back({node.kind == Node::And ? CompiledQuery::Instruction::And
+                                                       : CompiledQuery::Instruction::Or, {}, nullptr, 0});
+}
+
+void Query::collectConjuncts(const Node& node, CompiledQuery& compiled) {
+    if (node.kind == Node::Test) {
+        compiled.topLevel.push_back(node.predicate);
+    } else if (node.kind == Node::And) {
+        collectConjuncts(*node.children[0], compiled);
+        collectConjuncts(*node.children[1], compiled);
+    }
+}
+
+CompiledQuery Query::compile() const {
+    CompiledQuery compiled;
+    if (root) {
+        emit(*root, compiled);
+        collectConjuncts(*root, compiled);
+    }
+    return compiled;
+}
+
+// ==================== CompiledQuery 类实现 ====================
+
+namespace {
+
+template <typename T>
+bool compareValues(Query::Op op, const T& value, const T& low, const T& high) {
+    switch (op) {
+        case Query::Op::Eq: return value == low;
+        case Query::Op::Ne: return value != low;
+        case Query::Op::Lt: return value < low;
+        case Query::Op::Le: return value <= low;
+        case Query::Op::Gt: return value > low;
+        case Query::Op::Ge: return value >= low;
+        case Query::Op::Between: return value >= low && value <= high;
+        default: return false;
+    }
+}
+
+} // namespace
+
+bool CompiledQuery::test(const Query::Predicate& p, const Student& student) {
+    using Field = Query::Field;
+    
+    double number = 0;
+    const std::string* text = nullptr;
+    std::string gender;
+    switch (p.field) {
+        case Field::Id: text = &student.id; break;
+        case Field::Name: text = &student.name; break;
+        case Field::Department: text = &student.department; break;
+        case Field::Major: text = &student.major; break;
+        case Field::ClassName: text = &student.className; break;
+        case Field::Gender: gender.assign(1, student.gender); text = &gender; break;
+        case Field::Age: number = student.age; break;
+        case Field::Math: number = student.math; break;
+        case Field::Cpp: number = student.cpp; break;
+        case Field::English: number = student.english; break;
+        case Field::LinearAlgebra: number = student.linearAlgebra; break;
+        case Field::Political: number = student.political; break;
+        case Field::Total: number = student.totalScore; break;
+        case Field::Average: number = student.averageScore; break;
+        case Field::Rank: number = student.rank; break;
+    }
+    
+    if (text) {
+        if (p.op == Query::Op::Contains) {
+            return text->find(p.text) != std::string::npos;
+        }
+        return compareValues(p.op, *text, p.text, p.textHigh);
+    }
+    return compareValues(p.op, number, p.low, p.high);
+}
+
+void CompiledQuery::bindCategory(Query::Field field, const CategoryIndex& index) {
+    for (auto& instruction : program) {
+        const Query::Predicate& p = instruction.predicate;
+        if (instruction.kind == Instruction::Test && p.field == field &&
+            (p.op == Query::Op::Eq || p.op == Query::Op::Ne)) {
+            instruction.ids = index.ids();
+            instruction.valueId = index.values().find(p.text);  // 不存在时为 NONE，不会与任何记录相等
+        }
+    }
+}
+
+bool CompiledQuery::matches(const Student& student) const {
+    return run(student, NO_SLOT);
+}
+
+bool CompiledQuery::matches(const Student& student, uint32_t slot) const {
+    return run(student, slot);
+}
+
+bool CompiledQuery::run(const Student& student, uint32_t slot) const {
+    if (program.empty()) return true;
+    
+    // 求值栈，深度不超过程序长度
+    bool stack[64];
+    std::vector<bool> heapStack;
+    bool useHeap = program.size() > 64;
+    if (useHeap) heapStack.resize(program.size());
+    size_t top = 0;
+    
+    auto push = [&](bool v) { if (useHeap) heapStack[top++] = v; else stack[top++] = v; };
+    auto pop = [&]() { return useHeap ? bool(heapStack[--top]) : stack[--top]; };
+    
+    for (const auto& instruction : program) {
+        switch (instruction.kind) {
+            case Instruction::Test:
+                if (instruction.ids && slot != NO_SLOT) {
+                    bool equal = instruction.ids[slot] == instruction.valueId;
+                    push(instruction.predicate.op == Query::Op::Eq ? equal : !equal);
+                } else {
+                    push(test(instruction.predicate, student));
+                }
+                break;
+            case Instruction::Not:
+                push(!pop());
+                break;
+            case Instruction::And: {
+                bool b = pop(), a = pop();
+                push(a && b);
+                break;
+            }
+            case Instruction::Or: {
+                bool b = pop(), a = pop();
+                push(a || b);
+                break;
+            }
+        }
+    }
+    return pop();
+}
+
+// ==================== QueryParser 类实现 ====================
+
+// 递归下降解析：or < and < not < 谓词/括号
+class QueryParser {
+public:
+    QueryParser(const std::string& text) : text(text), pos(0) {}
+
+    bool parse(Query& query, std::string& error) {
+        tokenize();
+        if (!failure.empty()) {
+            error = failure;
+            return false;
+        }
+        if (tokens.empty()) {
+            query = Query();
+            return true;
+        }
+        
+        index = 0;
+        query = parseOr();
+        if (failure.empty() && index < tokens.size()) {
+            failure = "unexpected '" + tokens[index].text + "'";
+        }
+        error = failure;
+        return failure.empty();
+    }
+
+private:
+    struct Token {
+        std::string text;
+        bool quoted;
+    };
+
+    std::string text;
+    size_t pos;
+    std::vector<Token> tokens;
+    size_t index = 0;
+    std::string failure;
+
+    void tokenize() {
+        while (pos < text.size()) {
+            char c = text[pos];
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                pos++;
+            } else if (c == '(' || c == ')') {
+                tokens.push_back({std::string(1, c), false});
+                pos++;
+            } else if (c == '=' || c == '!' || c == '<' || c == '>') {
+                std::string op(1, c);
+                pos++;
+                if (pos < text.size() && text[pos] == '=') {
+                    op += '=';
+                    pos++;
+                }
+                tokens.push_back({op, false});
+            } else if (c == '\'' || c == '"') {
+                size_t end = text.find(c, pos + 1);
+                if (end == std::string::npos) {
+                    failure = "unterminated string";
+                    return;
+                }
+                tokens.push_back({text.substr(pos + 1, end - pos - 1), true});
+                pos = end + 1;
+            } else {
+                size_t start = pos;
+                while (pos < text.size() && !std::isspace(static_cast<unsigned char>(text[pos]))
+                       && std::string("()=!<>").find(text[pos]) == std::string::npos) {
+                    pos++;
+                }
+                tokens.push_back({text.substr(start, pos - start), false});
+            }
+        }
+    }
+
+    bool isKeyword(const char* keyword) const {
+        if (index >= tokens.size() || tokens[index].quoted) return false;
+        const std::string& t = tokens[index].text;
+        if (t.size() != std::char_traits<char>::length(keyword)) return false;
+        for (size_t i = 0; i < t.size(); i++) {
+            if (std::tolower(static_cast<unsigned char>(t[i])) != keyword[i]) return false;
+        }
+        return true;
+    }
+
+    bool next(std::string& out) {
+        if (index >= tokens.size()) {
+            if (failure.empty()) failure = "unexpected end of query";
+            return false;
+        }
+        out = tokens[index++].text;
+        return true;
+    }
+
+    Query parseOr() {
+        Query query = parseAnd();
+        while (failure.empty() && isKeyword("or")) {
+            index++;
+            query = query || parseAnd();
+        }
+        return query;
+    }
+
+    Query parseAnd() {
+        Query query = parseNot();
+        while (failure.empty() && isKeyword("and")) {
+            index++;
+            query = query && parseNot();
+        }
+        return query;
+    }
+
+    Query parseNot() {
+        if (isKeyword("not")) {
+            index++;
+            return !parseNot();
+        }
+        if (index < tokens.size() && !tokens[index].quoted && tokens[index].text == "(") {
+            index++;
+            Query query = parseOr();
+            if (failure.empty() && (index >= tokens.size() || tokens[index].text != ")")) {
+                failure = "missing ')'";
+            }
+            index++;
+            return query;
+        }
+        return parsePredicate();
+    }
+
+    bool parseNumber(const std::string& token, double& value) {
+        char* end = nullptr;
+        value = std::strtod(token.c_str(), &end);
+        if (token.empty() || *end != '\0') {
+            failure = "'" + token + "' is not a number";
+            return false;
+        }
+        return true;
+    }
+
+    Query parsePredicate() {
+        std::string fieldName, op, value;
+        if (!next(fieldName)) return Query();
+        
+        Query::Field field;
+        if (!Query::fieldFromName(fieldName, field)) {
+            failure = "unknown field '" + fieldName + "'";
+            return Query();
+        }
+        bool numeric = Query::isNumeric(field);
+        
+        if (isKeyword("between")) {
+            index++;
+            std::string low, high;
+            if (!next(low)) return Query();
+            if (!isKeyword("and")) {
+                failure = "expected 'and' in between";
+                return Query();
+            }
+            index++;
+            if (!next(high)) return Query();
+            
+            if (!numeric) {
+                Query query = Query::compare(field, Query::Op::Between, low);
+                std::const_pointer_cast<Query::Node>(query.root)->predicate.textHigh = high;
+                return query;
+            }
+            double lowValue, highValue;
+            if (!parseNumber(low, lowValue) || !parseNumber(high, highValue)) return Query();
+            return Query::between(field, lowValue, highValue);
+        }
+        
+        if (isKeyword("contains")) {
+            index++;
+            if (!next(value)) return Query();
+            if (numeric) {
+                failure = "contains requires a text field";
+                return Query();
+            }
+            return Query::contains(field, value);
+        }
+        
+        if (!next(op) || !next(value)) return Query();
+        
+        Query::Op compareOp;
+        if (op == "=" || op == "==") compareOp = Query::Op::Eq;
+        else if (op == "!=") compareOp = Query::Op::Ne;
+        else if (op == "<") compareOp = Query::Op::Lt;
+        else if (op == "<=") compareOp = Query::Op::Le;
+        else if (op == ">") compareOp = Query::Op::Gt;
+        else if (op == ">=") compareOp = Query::Op::Ge;
+        else {
+            failure = "unknown operator '" + op + "'";
+            return Query();
+        }
+        
+        if (!numeric) {
+            return Query::compare(field, compareOp, value);
+        }
+        double number;
+        if (!parseNumber(value, number)) return Query();
+        return Query::compare(field, compareOp, number);
+    }
+};
+
+bool Query::parse(const std::string& text, Query& query, std::string& error) {
+    QueryParser parser(text);
+    return parser.parse(query, error);
+}
@@ -0,0 +1,666 @@
+#include "query_server.hpp"
+#include "student_view.hpp"
+#include "query.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t MAX_EVENTS = 64;
+const size_t READ_CHUNK = 16 << 10;
+const size_t MAX_REQUEST_BYTES = 1 << 20;  // 请求头与请求体合计上限
+const size_t DEFAULT_LIMIT = 100;
+
+// SIGINT / SIGTERM 时写入当前服务的 eventfd
+volatile sig_atomic_t signalWakeFd = -1;
+
+void onSignal(int) {
+    if (signalWakeFd >= 0) {
+        uint64_t one = 1;
+        ssize_t ignored = write(signalWakeFd, &one, sizeof(one));
+        (void)ignored;
+    }
+}
+
+const char* reasonPhrase(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 409: return "Conflict";
+        case 413: return "Payload Too Large";
+        default: return "Internal Server Error";
+    }
+}
+
+// ---------- JSON 输出 ----------
+
+void appendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    static const char HEX[] = "0123456789abcdef";
+                    out += "\\u00";
+                    out += HEX[(c >> 4) & 0xf];
+                    out += HEX[c & 0xf];
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+void appendNumber(std::string& out, double value) {
+    char buf[32];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, res.ptr);
+}
+
+void appendNumber(std::string& out, long long value) {
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, res.ptr);
+}
+
+void appendNumber(std::string& out, size_t value) {
+    appendNumber(out, static_cast<long long>(value));
+}
+
+void appendNumber(std::string& out, int value) {
+    appendNumber(out, static_cast<long long>(value));
+}
+
+template <typename T>
+void appendField(std::string& out, const char* name, T value) {
+    out += '"';
+    out += name;
+    out += "\":";
+    appendNumber(out, value);
+    out += ',';
+}
+
+// rank 单独传入：共享锁下的只读查找不写回记录中的名次
+void appendStudent(std::string& out, const Student& student, int rank) {
+    out += "{\"id\":";
+    appendJsonString(out, student.id);
+    out += ",\"name\":";
+    appendJsonString(out, student.name);
+    out += ",\"gender\":";
+    appendJsonString(out, std::string_view(&student.gender, student.gender ? 1 : 0));
+    out += ",\"department\":";
+    appendJsonString(out, student.department);
+    out += ",\"major\":";
+    appendJsonString(out, student.major);
+    out += ",\"class\":";
+    appendJsonString(out, student.className);
+    out += ',';
+    appendField(out, "age", student.age);
+    appendField(out, "math", student.math);
+    appendField(out, "cpp", student.cpp);
+    appendField(out, "english", student.english);
+    appendField(out, "linearAlgebra", student.linearAlgebra);
+    appendField(out, "political", student.political);
+    appendField(out, "total", student.totalScore);
+    appendField(out, "average", student.averageScore);
+    appendField(out, "rank", rank);
+    out.back() = '}';
+}
+
+void appendStudent(std::string& out, const Student& student) {
+    appendStudent(out, student, student.rank);
+}
+
+// {"count":N,"students":[...]}，最多输出 limit 条
+void appendStudentList(std::string& out, const StudentView& students, size_t limit) {
+    out += "{\"count\":";
+    appendNumber(out, students.size());
+    out += ",\"students\":[";
+    size_t shown = std::min(limit, students.size());
+    for (size_t i = 0; i < shown; i++) {
+        if (i > 0) out += ',';
+        appendStudent(out, students[i]);
+    }
+    out += "]}";
+}
+
+void appendStatistics(std::string& out, const StudentManager::Statistics& stats) {
+    out += '{';
+    appendField(out, "totalStudents", stats.totalStudents);
+    appendField(out, "passCount", stats.passCount);
+    appendField(out, "failCount", stats.failCount);
+    appendField(out, "avgMath", stats.avgMath);
+    appendField(out, "avgCpp", stats.avgCpp);
+    appendField(out, "avgEnglish", stats.avgEnglish);
+    appendField(out, "avgLinearAlgebra", stats.avgLinearAlgebra);
+    appendField(out, "avgPolitical", stats.avgPolitical);
+    appendField(out, "overallAverage", stats.overallAverage);
+    out.back() = '}';
+}
+
+int errorResponse(std::string& body, int status, std::string_view message) {
+    body = "{\"error\":";
+    appendJsonString(body, message);
+    body += '}';
+    return status;
+}
+
+// ---------- 请求解析 ----------
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+std::string urlDecode(std::string_view text) {
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] == '+') {
+            out += ' ';
+        } else if (text[i] == '%' && i + 2 < text.size()
+                   && hexValue(text[i + 1]) >= 0 && hexValue(text[i + 2]) >= 0) {
+            out += static_cast<char>(hexValue(text[i + 1]) * 16 + hexValue(text[i + 2]));
+            i += 2;
+        } else {
+            out += text[i];
+        }
+    }
+    return out;
+}
+
+using Params = std::unordered_map<std::string, std::string>;
+
+void splitTarget(const std::string& target, std::string& path, Params& params) {
+    size_t mark = target.find('?');
+    path = urlDecode(std::string_view(target).substr(0, mark));
+    if (mark == std::string::npos) return;
+
+    std::string_view rest = std::string_view(target).substr(mark + 1);
+    while (!rest.empty()) {
+        size_t amp = rest.find('&');
+        std::string_view pair = rest.substr(0, amp);
+        size_t eq = pair.find('=');
+        if (!pair.empty()) {
+            params[urlDecode(pair.substr(0, eq))] =
+                eq == std::string_view::npos ? std::string() : urlDecode(pair.substr(eq + 1));
+        }
+        if (amp == std::string_view::npos) break;
+        rest.remove_prefix(amp + 1);
+    }
+}
+
+bool parseCount(const Params& params, const char* name, size_t fallback, size_t& value) {
+    auto found = params.find(name);
+    if (found == params.end()) {
+        value = fallback;
+        return true;
+    }
+    const std::string& text = found->second;
+    auto res = std::from_chars(text.data(), text.data() + text.size(), value);
+    return res.ec == std::errc() && res.ptr == text.data() + text.size();
+}
+
+bool columnFromName(const std::string& name, ScoreColumns::Column& column) {
+    static const std::pair<const char*, ScoreColumns::Column> COLUMNS[] = {
+        {"math", ScoreColumns::MATH}, {"cpp", ScoreColumns::CPP},
+        {"english", ScoreColumns::ENGLISH}, {"linearAlgebra", ScoreColumns::LINEAR_ALGEBRA},
+        {"political", ScoreColumns::POLITICAL}, {"average", ScoreColumns::AVERAGE},
+    };
+    for (const auto& entry : COLUMNS) {
+        if (name == entry.first) {
+            column = entry.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+    });
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+    return text;
+}
+
+} // namespace
+
+// ==================== QueryServer 类实现 ====================
+
+struct QueryServer::Connection {
+    explicit Connection(int fd) : fd(fd) {}
+
+    int fd;
+    std::string input;          // 已读入、尚未处理的字节
+    std::string output;         // 待写出的响应
+    size_t written = 0;
+    bool closeAfterWrite = false;
+};
+
+QueryServer::QueryServer(StudentManager& manager)
+    : manager(manager), listenFd(-1), epollFd(-1), wakeFd(-1), boundPort(0), threadCount(0),
+      stopping(false) {}
+
+QueryServer::~QueryServer() {
+    for (Connection* connection : connections) {
+        close(connection->fd);
+        delete connection;
+    }
+    if (listenFd >= 0) close(listenFd);
+    if (epollFd >= 0) close(epollFd);
+    if (wakeFd >= 0) close(wakeFd);
+}
+
+bool QueryServer::start(uint16_t port, size_t threads) {
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        error = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+        || listen(listenFd, SOMAXCONN) < 0) {
+        error = "cannot listen on port " + std::to_string(port) + ": " + std::strerror(errno);
+        return false;
+    }
+    socklen_t length = sizeof(address);
+    getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+    boundPort = ntohs(address.sin_port);
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        error = std::string("epoll: ") + std::strerror(errno);
+        return false;
+    }
+    // 监听套接字与 eventfd 用成员地址作标记，与 Connection* 区分
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.ptr = &listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.ptr = &wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+
+    threadCount = threads;
+    // 先刷新名次，之后持共享锁的读请求不会再修改管理器内部状态
+    manager.view();
+    return true;
+}
+
+void QueryServer::run() {
+    struct sigaction action{}, oldInt{}, oldTerm{};
+    action.sa_handler = onSignal;
+    sigemptyset(&action.sa_mask);
+    signalWakeFd = wakeFd;
+    sigaction(SIGINT, &action, &oldInt);
+    sigaction(SIGTERM, &action, &oldTerm);
+
+    {
+        ThreadPool workers(threadCount);
+        epoll_event events[MAX_EVENTS];
+        while (!stopping) {
+            int ready = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+            if (ready < 0) {
+                if (errno == EINTR) continue;
+                error = std::string("epoll_wait: ") + std::strerror(errno);
+                break;
+            }
+            for (int i = 0; i < ready; i++) {
+                void* tag = events[i].data.ptr;
+                if (tag == &listenFd) {
+                    acceptClients();
+                } else if (tag == &wakeFd) {
+                    stopping = true;
+                } else {
+                    // EPOLLONESHOT 保证同一连接同时只由一个工作线程处理
+                    auto* connection = static_cast<Connection*>(tag);
+                    bool writable = (events[i].events & EPOLLOUT) != 0;
+                    workers.submit([this, connection, writable]() { serve(connection, writable); });
+                }
+            }
+        }
+    }  // 等待已提交的请求处理完
+
+    sigaction(SIGINT, &oldInt, nullptr);
+    sigaction(SIGTERM, &oldTerm, nullptr);
+    signalWakeFd = -1;
+}
+
+void QueryServer::stop() {
+    uint64_t one = 1;
+    ssize_t ignored = write(wakeFd, &one, sizeof(one));
+    (void)ignored;
+}
+
+void QueryServer::acceptClients() {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;  // EAGAIN：已接受完所有挂起的连接
+        }
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        auto* connection = new Connection(fd);
+        {
+            std::lock_guard<std::mutex> guard(connectionsMutex);
+            connections.insert(connection);
+        }
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        event.data.ptr = connection;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            closeConnection(connection);
+        }
+    }
+}
+
+bool QueryServer::rearm(Connection* connection, bool wantWrite) {
+    epoll_event event{};
+    event.events = (wantWrite ? EPOLLOUT : EPOLLIN) | EPOLLRDHUP | EPOLLONESHOT;
+    event.data.ptr = connection;
+    return epoll_ctl(epollFd, EPOLL_CTL_MOD, connection->fd, &event) == 0;
+}
+
+void QueryServer::closeConnection(Connection* connection) {
+    {
+        std::lock_guard<std::mutex> guard(connectionsMutex);
+        connections.erase(connection);
+    }
+    close(connection->fd);
+    delete connection;
+}
+
+// 在工作线程中运行：读入数据、处理所有完整的请求、写回响应，最后重新登记事件
+void QueryServer::serve(Connection* connection, bool writable) {
+    bool peerClosed = false;
+
+    if (!writable) {
+        char buffer[READ_CHUNK];
+        while (true) {
+            ssize_t count = recv(connection->fd, buffer, sizeof(buffer), 0);
+            if (count > 0) {
+                connection->input.append(buffer, count);
+            } else if (count == 0) {
+                peerClosed = true;
+                break;
+            } else if (errno == EINTR) {
+                continue;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            } else {
+                closeConnection(connection);
+                return;
+            }
+        }
+
+        // 同一连接上可能有多个流水线请求
+        std::string& input = connection->input;
+        size_t consumed = 0;
+        while (!connection->closeAfterWrite) {
+            size_t headerEnd = input.find("\r\n\r\n", consumed);
+            if (headerEnd == std::string::npos) {
+                if (input.size() - consumed > MAX_REQUEST_BYTES) {
+                    std::string body;
+                    errorResponse(body, 413, "request too large");
+                    connection->output += "HTTP/1.1 413 Payload Too Large\r\nContent-Type: application/json\r\n"
+                                          "Connection: close\r\nContent-Length: ";
+                    connection->output += std::to_string(body.size()) + "\r\n\r\n" + body;
+                    connection->closeAfterWrite = true;
+                }
+                break;
+            }
+
+            // 请求行：<方法> <目标> <版本>
+            std::string_view head(input.data() + consumed, headerEnd - consumed);
+            size_t lineEnd = head.find("\r\n");
+            std::string_view requestLine = head.substr(0, lineEnd);
+            size_t sp1 = requestLine.find(' ');
+            size_t sp2 = requestLine.rfind(' ');
+            bool malformed = sp1 == std::string_view::npos || sp2 == sp1;
+            std::string method(requestLine.substr(0, sp1));
+            std::string target(malformed ? std::string_view() : requestLine.substr(sp1 + 1, sp2 - sp1 - 1));
+            bool keepAlive = !malformed && requestLine.substr(sp2 + 1) == "HTTP/1.1";
+
+            size_t contentLength = 0;
+            while (lineEnd != std::string_view::npos) {
+                head.remove_prefix(lineEnd + 2);
+                lineEnd = head.find("\r\n");
+                std::string_view line = head.substr(0, lineEnd);
+                size_t colon = line.find(':');
+                if (colon == std::string_view::npos) continue;
+                std::string_view name = line.substr(0, colon);
+                std::string_view value = trim(line.substr(colon + 1));
+                if (equalsIgnoreCase(name, "Content-Length")) {
+                    std::from_chars(value.data(), value.data() + value.size(), contentLength);
+                } else if (equalsIgnoreCase(name, "Connection")) {
+                    if (equalsIgnoreCase(value, "close")) keepAlive = false;
+                    if (equalsIgnoreCase(value, "keep-alive")) keepAlive = true;
+                }
+            }
+            if (contentLength > MAX_REQUEST_BYTES) {
+                malformed = true;
+                contentLength = 0;
+            }
+            size_t requestEnd = headerEnd + 4 + contentLength;
+            if (input.size() < requestEnd) break;  // 请求体尚未收全
+
+            std::string body;
+            int status = malformed
+                ? errorResponse(body, 400, "malformed request")
+                : handle(method, target, input.substr(headerEnd + 4, contentLength), body);
+            consumed = requestEnd;
+            if (malformed) keepAlive = false;
+
+            std::string& out = connection->output;
+            out += "HTTP/1.1 ";
+            out += std::to_string(status);
+            out += ' ';
+            out += reasonPhrase(status);
+            out += "\r\nContent-Type: application/json\r\nContent-Length: ";
+            out += std::to_string(body.size());
+            out += keepAlive ? "\r\n\r\n" : "\r\nConnection: close\r\n\r\n";
+            out += body;
+            connection->closeAfterWrite = !keepAlive;
+        }
+        input.erase(0, consumed);
+    }
+
+    std::string& output = connection->output;
+    while (connection->written < output.size()) {
+        ssize_t count = send(connection->fd, output.data() + connection->written,
+                             output.size() - connection->written, MSG_NOSIGNAL);
+        if (count > 0) {
+            connection->written += count;
+        } else if (count < 0 && errno == EINTR) {
+            continue;
+        } else if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!rearm(connection, true)) closeConnection(connection);
+            return;
+        } else {
+            closeConnection(connection);
+            return;
+        }
+    }
+    output.clear();
+    connection->written = 0;
+
+    if (connection->closeAfterWrite || peerClosed) {
+        closeConnection(connection);
+    } else if (!rearm(connection, false)) {
+        closeConnection(connection);
+    }
+}
+
+int QueryServer::handle(const std::string& method, const std::string& target,
+                        const std::string& requestBody, std::string& body) {
+    std::string path;
+    Params params;
+    splitTarget(target, path, params);
+
+    const std::string STUDENTS = "/students";
+    if (path.compare(0, STUDENTS.size() + 1, STUDENTS + "/") == 0 && path.size() > STUDENTS.size() + 1) {
+        std::string id = path.substr(STUDENTS.size() + 1);
+        if (method == "GET") {
+            std::shared_lock<std::shared_mutex> reader(lock);
+            // 只读查找：多个读者并发执行，不能写回记录中的名次
+            const StudentManager& readOnly = manager;
+            const Student* student = readOnly.findStudent(id);
+            if (!student) return errorResponse(body, 404, Status::notFound(id).message);
+            appendStudent(body, *student, readOnly.getRank(id));
+            return 200;
+        }
+        if (method == "DELETE") {
+            std::unique_lock<std::shared_mutex> writer(lock);
+            Status status = manager.deleteStudent(id);
+            manager.view();  // 在独占锁内刷新名次
+            if (!status) return errorResponse(body, 404, status.message);
+            body = "{\"deleted\":";
+            appendJsonString(body, id);
+            body += '}';
+            return 200;
+        }
+        return errorResponse(body, 405, "use GET or DELETE");
+    }
+
+    if (path == STUDENTS) {
+        if (method != "POST") return errorResponse(body, 405, "use POST");
+        Student student;
+        const char* parseError = nullptr;
+        if (!Student::parse(trim(requestBody), student, &parseError)) {
+            return errorResponse(body, 400, std::string("invalid student record: ")
+                                            + (parseError ? parseError : "malformed"));
+        }
+        student.calculateScores();
+
+        std::unique_lock<std::shared_mutex> writer(lock);
+        Status status = manager.addStudent(student);
+        manager.view();
+        if (!status) return errorResponse(body, 409, status.message);
+        appendStudent(body, *manager.findStudent(student.id));
+        return 201;
+    }
+
+    if (method != "GET") return errorResponse(body, 405, "use GET");
+
+    if (path == "/search") {
+        size_t limit = 0;
+        if (!parseCount(params, "limit", DEFAULT_LIMIT, limit)) {
+            return errorResponse(body, 400, "invalid limit");
+        }
+        auto q = params.find("q");
+        if (q != params.end()) {
+            Query query;
+            std::string queryError;
+            if (!Query::parse(q->second, query, queryError)) {
+                return errorResponse(body, 400, "invalid query: " + queryError);
+            }
+            std::shared_lock<std::shared_mutex> reader(lock);
+            appendStudentList(body, manager.query(query), limit);
+            return 200;
+        }
+        auto field = params.find("field");
+        auto value = params.find("value");
+        if (field == params.end() || value == params.end()) {
+            return errorResponse(body, 400, "expected q=<query> or field=<field>&value=<value>");
+        }
+        std::shared_lock<std::shared_mutex> reader(lock);
+        appendStudentList(body, manager.findStudentsByCondition(field->second, value->second), limit);
+        return 200;
+    }
+
+    if (path == "/stats") {
+        auto group = params.find("group");
+        if (group == params.end()) {
+            std::shared_lock<std::shared_mutex> reader(lock);
+            appendStatistics(body, manager.getStatistics());
+            return 200;
+        }
+        if (group->second != "department" && group->second != "major" && group->second != "class") {
+            return errorResponse(body, 400, "group must be department, major or class");
+        }
+        std::vector<StudentManager::GroupStatistics> groups;
+        {
+            std::shared_lock<std::shared_mutex> reader(lock);
+            groups = manager.getGroupedStatistics(group->second);
+        }
+        body = "{\"groups\":[";
+        for (size_t i = 0; i < groups.size(); i++) {
+            if (i > 0) body += ',';
+            body += "{\"key\":";
+            appendJsonString(body, groups[i].key);
+            body += ",\"stats\":";
+            appendStatistics(body, groups[i].stats);
+            body += '}';
+        }
+        body += "]}";
+        return 200;
+    }
+
+    if (path == "/top") {
+        size_t k = 0;
+        if (!parseCount(params, "k", 0, k) || k == 0) {
+            return errorResponse(body, 400, "expected k=<count>");
+        }
+        ScoreColumns::Column column = ScoreColumns::AVERAGE;
+        auto columnName = params.find("column");
+        if (columnName != params.end() && !columnFromName(columnName->second, column)) {
+            return errorResponse(body, 400, "unknown column " + columnName->second);
+        }
+        auto order = params.find("order");
+        bool highest = order == params.end() || order->second != "asc";
+
+        Query filter;
+        auto q = params.find("q");
+        if (q != params.end()) {
+            std::string queryError;
+            if (!Query::parse(q->second, filter, queryError)) {
+                return errorResponse(body, 400, "invalid query: " + queryError);
+            }
+        }
+        std::shared_lock<std::shared_mutex> reader(lock);
+        appendStudentList(body, manager.selectTop(column, k, highest, q != params.end() ? &filter : nullptr), k);
+        return 200;
+    }
+
+    return errorResponse(body, 404, "no such endpoint " + path);
+}
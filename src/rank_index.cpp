@@ -0,0 +1,269 @@
+#include "rank_index.hpp"
+#include "thread_pool.hpp"
+#include "memory_usage.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const size_t BUILD_MIN_CHUNK = 1 << 16;  // 每段至少这么多条记录才值得分给其他线程
+const size_t SCAN_BLOCKS = 64;           // 名次表扫描分块数
+
+} // namespace
+
+RankIndex::RankIndex() : tree(MAX_KEY + 2, 0), counts(MAX_KEY + 1, 0), values(MAX_KEY + 1, 0.0), total(0) {}
+
+// 分数 -> 桶号（超出 0~100 的分数归入两端的桶）
+int RankIndex::keyOf(double averageScore) {
+    long long key = std::llround(averageScore * 1000.0);
+    if (key < 0) return 0;
+    if (key > MAX_KEY) return MAX_KEY;
+    return static_cast<int>(key);
+}
+
+double RankIndex::scoreOf(int key) {
+    return key / 1000.0;
+}
+
+void RankIndex::clear() {
+    tree.assign(MAX_KEY + 2, 0);
+    counts.assign(MAX_KEY + 1, 0);
+    values.assign(MAX_KEY + 1, 0.0);
+    mixed.clear();
+    total = 0;
+}
+
+void RankIndex::add(int key, int delta) {
+    counts[key] += delta;
+    for (size_t i = key + 1; i < tree.size(); i += i & (~i + 1)) {
+        tree[i] += delta;
+    }
+}
+
+// 维护桶内的精确分数（在 counts 更新之前调用）
+void RankIndex::addValue(int key, double averageScore, int delta) {
+    auto found = mixed.find(key);
+    if (found == mixed.end()) {
+        if (counts[key] == 0 || values[key] == averageScore) {
+            values[key] = averageScore;
+            return;
+        }
+        // 桶内出现第二种分数：改为按分数分别计数
+        std::map<double, int>& bucket = mixed[key];
+        bucket[values[key]] = counts[key];
+        bucket[averageScore] += delta;
+        return;
+    }
+    
+    std::map<double, int>& bucket = found->second;
+    auto entry = bucket.emplace(averageScore, 0).first;
+    entry->second += delta;
+    if (entry->second <= 0) {
+        bucket.erase(entry);
+    }
+    if (bucket.size() == 1) {
+        values[key] = bucket.begin()->first;
+        mixed.erase(found);
+    }
+}
+
+size_t RankIndex::prefix(int key) const {
+    long long sum = 0;
+    for (size_t i = key + 1; i > 0; i -= i & (~i + 1)) {
+        sum += tree[i];
+    }
+    return static_cast<size_t>(sum);
+}
+
+size_t RankIndex::aboveInBucket(int key, double averageScore) const {
+    if (counts[key] == 0) {
+        return 0;
+    }
+    auto found = mixed.find(key);
+    if (found == mixed.end()) {
+        return values[key] > averageScore ? counts[key] : 0;
+    }
+    size_t above = 0;
+    for (auto it = found->second.upper_bound(averageScore); it != found->second.end(); ++it) {
+        above += it->second;
+    }
+    return above;
+}
+
+void RankIndex::insert(double averageScore) {
+    int key = keyOf(averageScore);
+    addValue(key, averageScore, 1);
+    add(key, 1);
+    total++;
+}
+
+void RankIndex::erase(double averageScore) {
+    int key = keyOf(averageScore);
+    addValue(key, averageScore, -1);
+    add(key, -1);
+    total--;
+}
+
+size_t RankIndex::countAbove(double averageScore) const {
+    int key = keyOf(averageScore);
+    return total - prefix(key) + aboveInBucket(key, averageScore);
+}
+
+int RankIndex::rankOf(double averageScore) const {
+    return static_cast<int>(countAbove(averageScore)) + 1;
+}
+
+// 树状数组上二分：找最大的位置 pos 使得前缀和 <= total - k，其右侧第一个桶即为答案
+double RankIndex::kthScore(size_t k) const {
+    if (k == 0 || k > total) {
+        return 0.0;
+    }
+    
+    size_t target = total - k;
+    size_t pos = 0;
+    size_t step = 1;
+    while (step * 2 < tree.size()) step *= 2;
+    
+    for (; step > 0; step /= 2) {
+        size_t next = pos + step;
+        if (next < tree.size() && static_cast<size_t>(tree[next]) <= target) {
+            pos = next;
+            target -= tree[next];
+        }
+    }
+    
+    // 答案在桶 pos 内，是桶内第 k - (更高桶人数) 高的分数
+    int key = static_cast<int>(pos);
+    auto found = mixed.find(key);
+    if (found == mixed.end()) {
+        return values[key];
+    }
+    size_t remaining = k - (total - prefix(key));
+    for (auto it = found->second.rbegin(); it != found->second.rend(); ++it) {
+        if (remaining <= static_cast<size_t>(it->second)) {
+            return it->first;
+        }
+        remaining -= it->second;
+    }
+    return found->second.begin()->first;
+}
+
+size_t RankIndex::size() const {
+    return total;
+}
+
+size_t RankIndex::memoryUsage() const {
+    size_t bytes = MemoryUsage::heapBytes(tree) + MemoryUsage::heapBytes(counts) + MemoryUsage::heapBytes(values)
+                 + MemoryUsage::hashTableBytes(mixed);
+    // 红黑树节点：值 + 三个指针 + 颜色
+    for (const auto& bucket : mixed) {
+        bytes += bucket.second.size() * (sizeof(std::pair<const double, int>) + 4 * sizeof(void*));
+    }
+    return bytes;
+}
+
+void RankIndex::build(const double* averageScores, size_t count) {
+    ThreadPool& pool = ThreadPool::shared();
+    size_t chunks = std::max<size_t>(1, std::min(pool.size(), count / BUILD_MIN_CHUNK));
+    size_t step = (count + chunks - 1) / std::max<size_t>(chunks, 1);
+    
+    // 每段各自统计，最后合并
+    std::vector<std::vector<int>> partial(chunks);
+    pool.parallelFor(chunks, 1, [&](size_t first, size_t last) {
+        for (size_t c = first; c < last; c++) {
+            std::vector<int>& local = partial[c];
+            local.assign(MAX_KEY + 1, 0);
+            size_t end = std::min(count, (c + 1) * step);
+            for (size_t i = c * step; i < end; i++) {
+                local[keyOf(averageScores[i])]++;
+            }
+        }
+    });
+    
+    counts.swap(partial[0]);
+    for (size_t c = 1; c < chunks; c++) {
+        for (int key = 0; key <= MAX_KEY; key++) {
+            counts[key] += partial[c][key];
+        }
+    }
+    
+    // 线性建树：每个节点把自身累加到父节点
+    tree.assign(MAX_KEY + 2, 0);
+    for (int key = 0; key <= MAX_KEY; key++) {
+        tree[key + 1] = counts[key];
+    }
+    for (size_t i = 1; i < tree.size(); i++) {
+        size_t parent = i + (i & (~i + 1));
+        if (parent < tree.size()) {
+            tree[parent] += tree[i];
+        }
+    }
+    total = count;
+    
+    // 记录各桶的分数，找出含多种分数的桶后再逐一计数
+    std::vector<unsigned char> state(MAX_KEY + 1, 0);  // 0 空，1 单一分数，2 多种分数
+    values.assign(MAX_KEY + 1, 0.0);
+    mixed.clear();
+    bool anyMixed = false;
+    for (size_t i = 0; i < count; i++) {
+        int key = keyOf(averageScores[i]);
+        if (state[key] == 0) {
+            state[key] = 1;
+            values[key] = averageScores[i];
+        } else if (state[key] == 1 && values[key] != averageScores[i]) {
+            state[key] = 2;
+            anyMixed = true;
+        }
+    }
+    if (anyMixed) {
+        for (size_t i = 0; i < count; i++) {
+            int key = keyOf(averageScores[i]);
+            if (state[key] == 2) {
+                mixed[key][averageScores[i]]++;
+            }
+        }
+    }
+}
+
+// 两趟分块扫描：先并行求各块人数，串行得到各块之上的人数，再并行填表
+void RankIndex::rankTable(std::vector<int>& table) const {
+    table.resize(MAX_KEY + 1);
+    size_t blockSize = (counts.size() + SCAN_BLOCKS - 1) / SCAN_BLOCKS;
+    std::vector<size_t> above(SCAN_BLOCKS, 0);
+    ThreadPool& pool = ThreadPool::shared();
+    
+    pool.parallelFor(SCAN_BLOCKS, 1, [&](size_t first, size_t last) {
+        for (size_t b = first; b < last; b++) {
+            size_t end = std::min(counts.size(), (b + 1) * blockSize);
+            size_t sum = 0;
+            for (size_t key = b * blockSize; key < end; key++) {
+                sum += counts[key];
+            }
+            above[b] = sum;
+        }
+    });
+    
+    size_t higher = 0;
+    for (size_t b = SCAN_BLOCKS; b-- > 0;) {
+        size_t blockTotal = above[b];
+        above[b] = higher;
+        higher += blockTotal;
+    }
+    
+    pool.parallelFor(SCAN_BLOCKS, 1, [&](size_t first, size_t last) {
+        for (size_t b = first; b < last; b++) {
+            size_t running = above[b];
+            size_t begin = b * blockSize;
+            size_t end = std::min(counts.size(), begin + blockSize);
+            for (size_t key = end; key-- > begin;) {
+                table[key] = static_cast<int>(running) + 1;
+                running += counts[key];
+            }
+        }
+    });
+}
+
+int RankIndex::rankOf(double averageScore, const std::vector<int>& table) const {
+    int key = keyOf(averageScore);
+    return table[key] + static_cast<int>(aboveInBucket(key, averageScore));
+}
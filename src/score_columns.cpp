@@ -0,0 +1,195 @@
+#include "score_columns.hpp"
+#include "student.hpp"
+#include "memory_usage.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SMS_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+// ==================== ScoreColumns 类实现 ====================
+
+namespace {
+
+double Student::* const columnFields[ScoreColumns::COLUMN_COUNT] = {
+    &Student::math, &Student::cpp, &Student::english,
+    &Student::linearAlgebra, &Student::political, &Student::averageScore
+};
+
+} // namespace
+
+void ScoreColumns::clear() {
+    for (auto& column : columns) column.clear();
+}
+
+void ScoreColumns::reserve(size_t count) {
+    for (auto& column : columns) column.reserve(count);
+}
+
+void ScoreColumns::push(const Student& student) {
+    for (int c = 0; c < COLUMN_COUNT; c++) {
+        columns[c].push_back(student.*columnFields[c]);
+    }
+}
+
+void ScoreColumns::set(size_t slot, const Student& student) {
+    for (int c = 0; c < COLUMN_COUNT; c++) {
+        columns[c][slot] = student.*columnFields[c];
+    }
+}
+
+void ScoreColumns::moveLastTo(size_t slot) {
+    for (auto& column : columns) column[slot] = column.back();
+}
+
+void ScoreColumns::popBack() {
+    for (auto& column : columns) column.pop_back();
+}
+
+size_t ScoreColumns::memoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& column : columns) bytes += MemoryUsage::heapBytes(column);
+    return bytes;
+}
+
+// ==================== ScoreKernels 类实现 ====================
+
+namespace {
+
+double sumScalar(const double* values, size_t count) {
+    // 四路累加，打断浮点加法的依赖链
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        s0 += values[i];
+        s1 += values[i + 1];
+        s2 += values[i + 2];
+        s3 += values[i + 3];
+    }
+    for (; i < count; i++) s0 += values[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+size_t countAtLeastScalar(const double* values, size_t count, double threshold) {
+    size_t n = 0;
+    for (size_t i = 0; i < count; i++) {
+        n += values[i] >= threshold;
+    }
+    return n;
+}
+
+#ifdef SMS_X86_KERNELS
+
+__attribute__((target("sse2")))
+double sumSSE2(const double* values, size_t count) {
+    __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        a0 = _mm_add_pd(a0, _mm_loadu_pd(values + i));
+        a1 = _mm_add_pd(a1, _mm_loadu_pd(values + i + 2));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(a0, a1));
+    double total = lanes[0] + lanes[1];
+    for (; i < count; i++) total += values[i];
+    return total;
+}
+
+__attribute__((target("sse2")))
+size_t countAtLeastSSE2(const double* values, size_t count, double threshold) {
+    __m128d limit = _mm_set1_pd(threshold);
+    size_t n = 0;
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        int mask = _mm_movemask_pd(_mm_cmpge_pd(_mm_loadu_pd(values + i), limit));
+        n += (mask & 1) + (mask >> 1);
+    }
+    for (; i < count; i++) n += values[i] >= threshold;
+    return n;
+}
+
+__attribute__((target("avx2")))
+double sumAVX2(const double* values, size_t count) {
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    __m256d a2 = _mm256_setzero_pd(), a3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        a0 = _mm256_add_pd(a0, _mm256_loadu_pd(values + i));
+        a1 = _mm256_add_pd(a1, _mm256_loadu_pd(values + i + 4));
+        a2 = _mm256_add_pd(a2, _mm256_loadu_pd(values + i + 8));
+        a3 = _mm256_add_pd(a3, _mm256_loadu_pd(values + i + 12));
+    }
+    __m256d acc = _mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3));
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    double total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < count; i++) total += values[i];
+    return total;
+}
+
+__attribute__((target("avx2")))
+size_t countAtLeastAVX2(const double* values, size_t count, double threshold) {
+    __m256d limit = _mm256_set1_pd(threshold);
+    // 比较结果为全 1（即 -1），累加后取负得到计数
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d ge = _mm256_cmp_pd(_mm256_loadu_pd(values + i), limit, _CMP_GE_OQ);
+        acc = _mm256_sub_epi64(acc, _mm256_castpd_si256(ge));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    size_t n = static_cast<size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    for (; i < count; i++) n += values[i] >= threshold;
+    return n;
+}
+
+#endif // SMS_X86_KERNELS
+
+enum class KernelLevel { Scalar, SSE2, AVX2 };
+
+KernelLevel detectLevel() {
+#ifdef SMS_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return KernelLevel::AVX2;
+    if (__builtin_cpu_supports("sse2")) return KernelLevel::SSE2;
+#endif
+    return KernelLevel::Scalar;
+}
+
+KernelLevel kernelLevel() {
+    static const KernelLevel level = detectLevel();
+    return level;
+}
+
+} // namespace
+
+double ScoreKernels::sum(const double* values, size_t count) {
+#ifdef SMS_X86_KERNELS
+    switch (kernelLevel()) {
+        case KernelLevel::AVX2: return sumAVX2(values, count);
+        case KernelLevel::SSE2: return sumSSE2(values, count);
+        default: break;
+    }
+#endif
+    return sumScalar(values, count);
+}
+
+size_t ScoreKernels::countAtLeast(const double* values, size_t count, double threshold) {
+#ifdef SMS_X86_KERNELS
+    switch (kernelLevel()) {
+        case KernelLevel::AVX2: return countAtLeastAVX2(values, count, threshold);
+        case KernelLevel::SSE2: return countAtLeastSSE2(values, count, threshold);
+        default: break;
+    }
+#endif
+    return countAtLeastScalar(values, count, threshold);
+}
+
+const char* ScoreKernels::implementation() {
+    switch (kernelLevel()) {
+        case KernelLevel::AVX2: return "AVX2";
+        case KernelLevel::SSE2: return "SSE2";
+        default: return "scalar";
+    }
+}
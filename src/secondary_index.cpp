@@ -0,0 +1,130 @@
+#include "secondary_index.hpp"
+#include "memory_usage.hpp"
+#include <algorithm>
+
+// ==================== CategoryIndex 类实现 ====================
+
+void CategoryIndex::clear() {
+    table.clear();
+    postings.clear();
+    positions.clear();
+    slotIds.clear();
+}
+
+void CategoryIndex::insert(uint32_t slot, const std::string& key) {
+    uint32_t id = table.intern(key);
+    if (postings.size() <= id) {
+        postings.resize(id + 1);
+    }
+    if (positions.size() <= slot) {
+        positions.resize(slot + 1);
+        slotIds.resize(slot + 1);
+    }
+    
+    std::vector<uint32_t>& list = postings[id];
+    positions[slot] = static_cast<uint32_t>(list.size());
+    slotIds[slot] = id;
+    list.push_back(slot);
+}
+
+void CategoryIndex::erase(uint32_t slot) {
+    std::vector<uint32_t>& list = postings[slotIds[slot]];
+    uint32_t pos = positions[slot];
+    uint32_t lastSlot = list.back();
+    list[pos] = lastSlot;
+    positions[lastSlot] = pos;
+    list.pop_back();
+}
+
+void CategoryIndex::move(uint32_t from, uint32_t to) {
+    uint32_t id = slotIds[from];
+    uint32_t pos = positions[from];
+    postings[id][pos] = to;
+    positions[to] = pos;
+    slotIds[to] = id;
+}
+
+const std::vector<uint32_t>* CategoryIndex::find(const std::string& key) const {
+    return find(table.find(key));
+}
+
+// 编号保留到 clear() 为止，取值暂时没有记录时返回 nullptr
+const std::vector<uint32_t>* CategoryIndex::find(uint32_t id) const {
+    if (id >= postings.size() || postings[id].empty()) {
+        return nullptr;
+    }
+    return &postings[id];
+}
+
+size_t CategoryIndex::memoryUsage() const {
+    size_t bytes = table.memoryUsage() + MemoryUsage::heapBytes(postings)
+                 + MemoryUsage::heapBytes(positions) + MemoryUsage::heapBytes(slotIds);
+    for (const auto& list : postings) bytes += MemoryUsage::heapBytes(list);
+    return bytes;
+}
+
+// ==================== TrigramIndex 类实现 ====================
+
+uint32_t TrigramIndex::trigramAt(std::string_view text, size_t pos) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(text[pos])) << 16)
+         | (static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8)
+         | static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+}
+
+void TrigramIndex::clear() {
+    postings.clear();
+    live = 0;
+    stale = 0;
+}
+
+void TrigramIndex::insert(uint32_t slot, const std::string& value) {
+    live++;
+    if (value.size() < 3) return;
+    
+    // 同一个值中重复的三元组只记一次
+    std::vector<uint32_t> grams;
+    grams.reserve(value.size() - 2);
+    for (size_t i = 0; i + 3 <= value.size(); i++) {
+        grams.push_back(trigramAt(value, i));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    
+    for (uint32_t gram : grams) {
+        postings[gram].push_back(slot);
+    }
+}
+
+void TrigramIndex::markStale(size_t count) {
+    stale += count;
+    live = live > count ? live - count : 0;
+}
+
+bool TrigramIndex::needsRebuild() const {
+    return stale > 1024 && stale > live;
+}
+
+// 选出最短的倒排列表作为候选集，其余条件交给调用者回表校验
+std::vector<uint32_t> TrigramIndex::candidates(std::string_view pattern) const {
+    const std::vector<uint32_t>* shortest = nullptr;
+    for (size_t i = 0; i + 3 <= pattern.size(); i++) {
+        auto found = postings.find(trigramAt(pattern, i));
+        if (found == postings.end()) {
+            return {};
+        }
+        if (!shortest || found->second.size() < shortest->size()) {
+            shortest = &found->second;
+        }
+    }
+    
+    std::vector<uint32_t> result(shortest->begin(), shortest->end());
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+size_t TrigramIndex::memoryUsage() const {
+    size_t bytes = MemoryUsage::hashTableBytes(postings);
+    for (const auto& entry : postings) bytes += MemoryUsage::heapBytes(entry.second);
+    return bytes;
+}
@@ -0,0 +1,408 @@
+#include "sort_keys.hpp"
+#include "student.hpp"
+#include "thread_pool.hpp"
+#include "intern_table.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <sstream>
+
+namespace {
+
+const uint64_t SIGN_BIT = uint64_t(1) << 63;
+const int RADIX_BITS = 11;                  // 每趟 2048 个桶
+const int MAX_RADIX_PASSES = 4;             // 键宽不超过 44 位才走基数排序
+const size_t RADIX_MIN_COUNT = 1024;        // 太少时比较排序更快
+const size_t PARALLEL_SORT_MIN_CHUNK = 1 << 16;  // 每段至少这么多条才并行排序
+
+// 浮点数 -> 保序的无符号整数：正数置符号位，负数整体取反
+uint64_t doubleKey(double value) {
+    if (value == 0) value = 0;  // -0.0 与 0.0 相等
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & SIGN_BIT) ? ~bits : bits | SIGN_BIT;
+}
+
+uint64_t intKey(int value) {
+    return static_cast<uint64_t>(static_cast<int64_t>(value)) ^ SIGN_BIT;
+}
+
+const std::string* textField(const Student& student, Query::Field field) {
+    switch (field) {
+        case Query::Field::Id: return &student.id;
+        case Query::Field::Name: return &student.name;
+        case Query::Field::Department: return &student.department;
+        case Query::Field::Major: return &student.major;
+        case Query::Field::ClassName: return &student.className;
+        default: return nullptr;
+    }
+}
+
+double doubleField(const Student& student, Query::Field field) {
+    switch (field) {
+        case Query::Field::Math: return student.math;
+        case Query::Field::Cpp: return student.cpp;
+        case Query::Field::English: return student.english;
+        case Query::Field::LinearAlgebra: return student.linearAlgebra;
+        case Query::Field::Political: return student.political;
+        case Query::Field::Total: return student.totalScore;
+        case Query::Field::Average: return student.averageScore;
+        default: return 0;
+    }
+}
+
+bool isDoubleField(Query::Field field) {
+    switch (field) {
+        case Query::Field::Math: case Query::Field::Cpp: case Query::Field::English:
+        case Query::Field::LinearAlgebra: case Query::Field::Political:
+        case Query::Field::Total: case Query::Field::Average:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// 成绩是两位小数（总分、平均分由其算出，落在 0.01 / 0.002 的网格上），整列都在浮点误差内
+// 落在 0.01 或 0.001 网格上时改用定点整数键：值域只有十几位，基数排序两趟即可。
+// 同一网格点上只差舍入误差的值视为相等（与排名索引的量化一致）；有不在网格上的值时返回 false
+bool fixedPointColumn(const std::vector<Student>& students, Query::Field field, std::vector<uint64_t>& column) {
+    static const double scales[] = {100.0, 1000.0};
+    column.resize(students.size());
+    for (double scale : scales) {
+        bool exact = true;
+        for (size_t i = 0; i < students.size() && exact; i++) {
+            double value = doubleField(students[i], field);
+            double scaled = std::round(value * scale);
+            if (!(std::fabs(scaled) < 1e15) || std::fabs(value * scale - scaled) > 1e-6) {
+                exact = false;
+            } else {
+                column[i] = static_cast<uint64_t>(static_cast<int64_t>(scaled)) ^ SIGN_BIT;
+            }
+        }
+        if (exact) return true;
+    }
+    return false;
+}
+
+uint64_t numericKey(const Student& student, Query::Field field) {
+    switch (field) {
+        case Query::Field::Gender: return static_cast<unsigned char>(student.gender);
+        case Query::Field::Age: return intKey(student.age);
+        case Query::Field::Rank: return intKey(student.rank);
+        default: return doubleKey(doubleField(student, field));
+    }
+}
+
+// 从 offset 起取 8 字节按大端打包，不足补 0
+uint64_t packPrefix(const std::string& text, size_t offset) {
+    uint64_t prefix = 0;
+    for (size_t i = 0; i < 8; i++) {
+        prefix <<= 8;
+        if (offset + i < text.size()) {
+            prefix |= static_cast<unsigned char>(text[offset + i]);
+        }
+    }
+    return prefix;
+}
+
+// 字符串列 -> 稠密序号，相等的字符串序号相同
+// 打包前缀相同且两串都不长于 offset + 8 时，长度就能决定先后，只有更长的串才回到逐字节比较
+std::vector<uint64_t> stringOrdinals(const std::vector<Student>& students, Query::Field field) {
+    size_t n = students.size();
+    std::vector<uint64_t> ordinals(n, 0);
+    if (n == 0) return ordinals;
+
+    // 所有值的公共前缀不参与区分，打包时跳过
+    const std::string& first = *textField(students[0], field);
+    size_t common = first.size();
+    for (size_t i = 1; i < n && common > 0; i++) {
+        const std::string& text = *textField(students[i], field);
+        size_t limit = std::min(common, text.size());
+        size_t j = 0;
+        while (j < limit && text[j] == first[j]) j++;
+        common = j;
+    }
+    size_t packed = common + 8;
+
+    struct Entry {
+        uint64_t prefix;
+        uint32_t length;
+        uint32_t slot;
+    };
+    std::vector<Entry> entries(n);
+    for (size_t i = 0; i < n; i++) {
+        const std::string& text = *textField(students[i], field);
+        entries[i] = {packPrefix(text, common), static_cast<uint32_t>(text.size()), static_cast<uint32_t>(i)};
+    }
+
+    // 返回 <0 / 0 / >0
+    auto compare = [&](const Entry& a, const Entry& b) -> int {
+        if (a.prefix != b.prefix) return a.prefix < b.prefix ? -1 : 1;
+        if (a.length <= packed && b.length <= packed) {
+            return a.length == b.length ? 0 : (a.length < b.length ? -1 : 1);
+        }
+        const std::string& x = *textField(students[a.slot], field);
+        const std::string& y = *textField(students[b.slot], field);
+        return x.compare(common, std::string::npos, y, common, std::string::npos);
+    };
+    std::sort(entries.begin(), entries.end(),
+        [&](const Entry& a, const Entry& b) { return compare(a, b) < 0; });
+
+    uint64_t ordinal = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (i > 0 && compare(entries[i - 1], entries[i]) != 0) ordinal++;
+        ordinals[entries[i].slot] = ordinal;
+    }
+    return ordinals;
+}
+
+// 把键列换成稠密序号（保序），位宽从 64 降到 log2(不同取值数)
+void compressColumn(std::vector<uint64_t>& column) {
+    std::vector<uint64_t> distinct = column;
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+    for (auto& value : column) {
+        value = std::lower_bound(distinct.begin(), distinct.end(), value) - distinct.begin();
+    }
+}
+
+using KeyedSlot = std::pair<uint64_t, uint32_t>;
+
+// LSD 基数排序（每趟稳定），width 为键的有效位数；同键保持输入顺序
+void radixSort(KeyedSlot* first, KeyedSlot* last, int width) {
+    const size_t buckets = size_t(1) << RADIX_BITS;
+    size_t count = last - first;
+    int passes = (width + RADIX_BITS - 1) / RADIX_BITS;
+    if (count < 2 || passes == 0) return;
+    
+    // 一次扫描统计所有趟的桶计数
+    std::vector<size_t> counts(passes * buckets, 0);
+    for (const KeyedSlot* item = first; item != last; ++item) {
+        for (int p = 0; p < passes; p++) {
+            counts[p * buckets + ((item->first >> (p * RADIX_BITS)) & (buckets - 1))]++;
+        }
+    }
+    
+    std::vector<KeyedSlot> buffer(count);
+    KeyedSlot* from = first;
+    KeyedSlot* to = buffer.data();
+    for (int p = 0; p < passes; p++) {
+        size_t* bucket = &counts[p * buckets];
+        if (bucket[(from[0].first >> (p * RADIX_BITS)) & (buckets - 1)] == count) {
+            continue;  // 这一位全部相同
+        }
+        size_t offset = 0;
+        for (size_t b = 0; b < buckets; b++) {
+            size_t c = bucket[b];
+            bucket[b] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < count; i++) {
+            to[bucket[(from[i].first >> (p * RADIX_BITS)) & (buckets - 1)]++] = from[i];
+        }
+        std::swap(from, to);
+    }
+    if (from != first) {
+        std::copy(from, from + count, first);
+    }
+}
+
+// 并行排序：切成与线程数相同的段分别排序，再逐轮两两归并
+// less 必须是全序（调用者用下标打破平局），因此结果与串行排序完全相同
+template <typename T, typename Less, typename SortRange>
+void parallelSort(std::vector<T>& items, Less less, SortRange sortRange) {
+    ThreadPool& pool = ThreadPool::shared();
+    size_t n = items.size();
+    size_t chunks = std::min(pool.size(), n / PARALLEL_SORT_MIN_CHUNK);
+    if (chunks <= 1) {
+        sortRange(items.data(), items.data() + n);
+        return;
+    }
+    
+    std::vector<size_t> bounds(chunks + 1);
+    for (size_t c = 0; c <= chunks; c++) {
+        bounds[c] = n * c / chunks;
+    }
+    pool.parallelFor(chunks, 1, [&](size_t first, size_t last) {
+        for (size_t c = first; c < last; c++) {
+            sortRange(items.data() + bounds[c], items.data() + bounds[c + 1]);
+        }
+    });
+    
+    std::vector<T> buffer(n);
+    while (bounds.size() > 2) {
+        size_t runs = bounds.size() - 1;
+        pool.parallelFor((runs + 1) / 2, 1, [&](size_t first, size_t last) {
+            for (size_t pair = first; pair < last; pair++) {
+                size_t left = bounds[2 * pair];
+                size_t mid = bounds[std::min(2 * pair + 1, runs)];
+                size_t right = bounds[std::min(2 * pair + 2, runs)];
+                std::merge(items.begin() + left, items.begin() + mid, items.begin() + mid, items.begin() + right,
+                           buffer.begin() + left, less);
+            }
+        });
+        items.swap(buffer);
+        
+        std::vector<size_t> merged;
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            merged.push_back(bounds[i]);
+        }
+        if (merged.back() != n) merged.push_back(n);
+        bounds.swap(merged);
+    }
+}
+
+int bitWidth(uint64_t value) {
+    int width = 0;
+    while (value) {
+        width++;
+        value >>= 1;
+    }
+    return width;
+}
+
+} // namespace
+
+// ==================== SortKeys 类实现 ====================
+
+bool SortKeys::parse(const std::string& text, std::vector<SortKey>& keys, std::string& error) {
+    keys.clear();
+    std::stringstream stream(text);
+    std::string item;
+
+    while (std::getline(stream, item, ',')) {
+        std::istringstream words(item);
+        std::string name, direction, extra;
+        if (!(words >> name)) {
+            error = "empty sort column";
+            return false;
+        }
+
+        SortKey key;
+        if (name[0] == '-' || name[0] == '+') {
+            key.ascending = name[0] == '+';
+            name.erase(0, 1);
+        }
+        if (!Query::fieldFromName(name, key.field)) {
+            error = "unknown field '" + name + "'";
+            return false;
+        }
+        if (words >> direction) {
+            std::transform(direction.begin(), direction.end(), direction.begin(),
+                           [](unsigned char c) { return std::tolower(c); });
+            if (direction == "asc") {
+                key.ascending = true;
+            } else if (direction == "desc") {
+                key.ascending = false;
+            } else {
+                error = "expected 'asc' or 'desc' after '" + name + "'";
+                return false;
+            }
+        }
+        if (words >> extra) {
+            error = "unexpected '" + extra + "'";
+            return false;
+        }
+        keys.push_back(key);
+    }
+
+    if (keys.empty()) {
+        error = "no sort columns given";
+        return false;
+    }
+    return true;
+}
+
+std::vector<uint32_t> SortKeys::order(const std::vector<Student>& students, const std::vector<SortKey>& keys,
+                                      const std::vector<InternedColumn>& interned) {
+    size_t n = students.size();
+    std::vector<uint32_t> slots(n);
+    for (size_t i = 0; i < n; i++) {
+        slots[i] = static_cast<uint32_t>(i);
+    }
+    if (n < 2 || keys.empty()) return slots;
+
+    // 每列规整为从 0 开始的无符号键，降序列取反
+    std::vector<std::vector<uint64_t>> columns;
+    std::vector<int> widths;
+    for (const auto& key : keys) {
+        std::vector<uint64_t> column;
+        if (Query::isNumeric(key.field) || key.field == Query::Field::Gender) {
+            if (!isDoubleField(key.field) || !fixedPointColumn(students, key.field, column)) {
+                column.resize(n);
+                for (size_t i = 0; i < n; i++) {
+                    column[i] = numericKey(students[i], key.field);
+                }
+            }
+        } else {
+            auto found = std::find_if(interned.begin(), interned.end(),
+                [&key](const InternedColumn& c) { return c.field == key.field; });
+            if (found != interned.end()) {
+                std::vector<uint32_t> rank = found->values->sortedOrder();
+                column.resize(n);
+                for (size_t i = 0; i < n; i++) {
+                    column[i] = rank[found->ids[i]];
+                }
+            } else {
+                column = stringOrdinals(students, key.field);
+            }
+        }
+
+        auto range = std::minmax_element(column.begin(), column.end());
+        uint64_t low = *range.first;
+        uint64_t span = *range.second - low;
+        for (auto& value : column) {
+            value = key.ascending ? value - low : span - (value - low);
+        }
+        columns.push_back(std::move(column));
+        widths.push_back(bitWidth(span));
+    }
+
+    int totalWidth = 0;
+    for (int width : widths) totalWidth += width;
+    
+    // 拼不下时把宽的数值列压成序号再试（字符串列已经是序号）
+    for (size_t c = 0; c < columns.size() && totalWidth > 64 && columns.size() > 1; c++) {
+        if (widths[c] <= 32) continue;
+        compressColumn(columns[c]);
+        totalWidth -= widths[c];
+        widths[c] = bitWidth(*std::max_element(columns[c].begin(), columns[c].end()));
+        totalWidth += widths[c];
+    }
+
+    if (totalWidth <= 64) {
+        // 拼成单个整数键，同键按下标，等价于稳定排序；键够窄时用线性时间的基数排序
+        std::vector<KeyedSlot> packed(n);
+        for (size_t i = 0; i < n; i++) {
+            uint64_t composite = 0;
+            for (size_t c = 0; c < columns.size(); c++) {
+                if (widths[c] == 0) continue;
+                composite = (widths[c] == 64 ? 0 : composite << widths[c]) | columns[c][i];
+            }
+            packed[i] = {composite, static_cast<uint32_t>(i)};
+        }
+        bool radix = n >= RADIX_MIN_COUNT && totalWidth <= MAX_RADIX_PASSES * RADIX_BITS;
+        parallelSort(packed, std::less<KeyedSlot>(), [radix, totalWidth](KeyedSlot* first, KeyedSlot* last) {
+            if (radix) {
+                radixSort(first, last, totalWidth);
+            } else {
+                std::sort(first, last);
+            }
+        });
+        for (size_t i = 0; i < n; i++) {
+            slots[i] = packed[i].second;
+        }
+        return slots;
+    }
+
+    auto less = [&columns](uint32_t a, uint32_t b) {
+        for (const auto& column : columns) {
+            if (column[a] != column[b]) return column[a] < column[b];
+        }
+        return a < b;
+    };
+    parallelSort(slots, less, [&less](uint32_t* first, uint32_t* last) { std::sort(first, last, less); });
+    return slots;
+}
@@ -0,0 +1,513 @@
+#include "storage.hpp"
+#include "binary_format.hpp"
+#include "mapped_file.hpp"
+#include "buffered_writer.hpp"
+#include "journal.hpp"
+#include "thread_pool.hpp"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <sstream>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <future>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// ==================== FileStorage 类实现 ====================
+
+FileStorage::FileStorage()
+    : dataDir("data"), dataFile("data/students.txt"), format(DataFormat::Text),
+      journal(nullptr), snapshotSequence(0) {
+    ensureDataDirectory();
+}
+
+void FileStorage::ensureDataDirectory() {
+    if (!dataDir.empty() && !fs::exists(dataDir)) {
+        fs::create_directory(dataDir);
+    }
+}
+
+void FileStorage::setDataFile(const std::string& path) {
+    dataFile = path;
+    dataDir = fs::path(path).parent_path().string();
+    ensureDataDirectory();
+    
+    // 根据扩展名选择默认格式
+    format = fs::path(path).extension() == ".bin" ? DataFormat::Binary : DataFormat::Text;
+}
+
+void FileStorage::setFormat(DataFormat newFormat) {
+    format = newFormat;
+}
+
+DataFormat FileStorage::getFormat() const {
+    return format;
+}
+
+const std::string& FileStorage::getDataFile() const {
+    return dataFile;
+}
+
+void FileStorage::setJournal(Journal* newJournal) {
+    journal = newJournal;
+}
+
+uint64_t FileStorage::getSnapshotSequence() const {
+    return snapshotSequence;
+}
+
+namespace {
+
+// 记录数超过该值时启用后台写入线程
+const size_t BACKGROUND_WRITE_THRESHOLD = 100000;
+
+const char TEXT_HEADER[] =
+    "# Student Management System Data File\n"
+    "# Format: id|name|gender|age|department|major|class|math|cpp|english|linearAlgebra|political|totalScore|averageScore|rank\n";
+
+const char SEQUENCE_MARKER[] = "# Journal-Sequence: ";
+
+const char CSV_HEADER[] =
+    "StudentID,Name,Gender,Age,Department,Major,Class,Math,C++,English,LinearAlgebra,Political,TotalScore,AverageScore,Rank\n";
+
+// 与 ostream 默认格式（%g，6 位有效数字）一致
+void appendGeneral(std::string& out, double value) {
+    char buf[32];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::general, 6);
+    out.append(buf, res.ptr);
+}
+
+void appendInt(std::string& out, int value) {
+    char buf[16];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, res.ptr);
+}
+
+void appendCSVRow(std::string& out, const Student& student) {
+    out += student.id; out += ',';
+    out += student.name; out += ',';
+    out += student.gender; out += ',';
+    appendInt(out, student.age); out += ',';
+    out += student.department; out += ',';
+    out += student.major; out += ',';
+    out += student.className; out += ',';
+    appendGeneral(out, student.math); out += ',';
+    appendGeneral(out, student.cpp); out += ',';
+    appendGeneral(out, student.english); out += ',';
+    appendGeneral(out, student.linearAlgebra); out += ',';
+    appendGeneral(out, student.political); out += ',';
+    appendGeneral(out, student.totalScore); out += ',';
+    appendGeneral(out, student.averageScore); out += ',';
+    appendInt(out, student.rank); out += '\n';
+}
+
+// 读取文本快照头部的日志序号，没有时返回 0
+uint64_t readTextSequence(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    const size_t markerLength = sizeof(SEQUENCE_MARKER) - 1;
+    while (std::getline(file, line) && !line.empty() && line[0] == '#') {
+        if (line.compare(0, markerLength, SEQUENCE_MARKER) == 0) {
+            try {
+                return std::stoull(line.substr(markerLength));
+            } catch (const std::exception&) {
+                return 0;
+            }
+        }
+    }
+    return 0;
+}
+
+// 把目录项的变更（rename）也刷到磁盘
+void syncDirectory(const std::string& dir) {
+#ifndef _WIN32
+    int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+#else
+    (void)dir;
+#endif
+}
+
+} // namespace
+
+bool FileStorage::writeTextFile(const StudentView& students, const std::string& path,
+                                uint64_t sequence, bool durable) {
+    BufferedWriter writer(BufferedWriter::DEFAULT_CAPACITY, students.size() >= BACKGROUND_WRITE_THRESHOLD);
+    if (!writer.open(path)) {
+        std::cerr << "Error: Cannot open file " << path << " for writing!\n";
+        return false;
+    }
+    
+    // 写入数据头
+    writer.append(TEXT_HEADER, sizeof(TEXT_HEADER) - 1);
+    if (sequence > 0) {
+        writer.buffer() += SEQUENCE_MARKER;
+        writer.buffer() += std::to_string(sequence);
+        writer.buffer() += '\n';
+    }
+    
+    // 每条记录直接格式化进输出缓冲区
+    for (const auto& student : students) {
+        student.appendTo(writer.buffer());
+        writer.buffer() += '\n';
+        writer.commitIfFull();
+    }
+    
+    if ((durable && !writer.sync()) || !writer.close()) {
+        std::cerr << "Error: Failed to write " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+namespace {
+
+// 一个数据块的解析结果
+struct ChunkResult {
+    std::vector<Student> students;
+    std::vector<std::pair<int, const char*>> warnings;  // 块内行号, 错误信息
+    int lineCount = 0;
+};
+
+// 解析 [begin, end) 中的所有行，begin 必须位于行首
+void parseChunk(const char* begin, const char* end, ChunkResult& result) {
+    const char* pos = begin;
+    while (pos < end) {
+        const char* newline = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+        const char* lineEnd = newline ? newline : end;
+        std::string_view line(pos, lineEnd - pos);
+        pos = lineEnd + 1;
+        result.lineCount++;
+        
+        // 跳过空行和注释行
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        
+        // 直接解析到末尾元素，失败时撤销
+        const char* error = nullptr;
+        result.students.emplace_back();
+        if (!Student::parse(line, result.students.back(), &error)) {
+            result.students.pop_back();
+            result.warnings.emplace_back(result.lineCount, error);
+        }
+    }
+}
+
+} // namespace
+
+// 映射整个文件，按换行符切块后在线程池上并行解析，再按原顺序合并
+bool FileStorage::readTextFile(const std::string& path, std::vector<Student>& students) {
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    
+    const char* data = file.data();
+    size_t size = file.size();
+    
+    // 小文件不值得切块
+    const size_t minChunkBytes = 1 << 20;
+    size_t chunkCount = 1;
+    if (size >= 2 * minChunkBytes) {
+        chunkCount = std::min(ThreadPool::shared().size() * 4, size / minChunkBytes);
+        chunkCount = std::max<size_t>(chunkCount, 1);
+    }
+    
+    // 块边界向后对齐到下一行的行首
+    std::vector<size_t> bounds(chunkCount + 1, size);
+    bounds[0] = 0;
+    for (size_t i = 1; i < chunkCount; i++) {
+        size_t pos = std::max(bounds[i - 1], size / chunkCount * i);
+        const char* newline = pos < size
+            ? static_cast<const char*>(std::memchr(data + pos, '\n', size - pos)) : nullptr;
+        bounds[i] = newline ? static_cast<size_t>(newline - data) + 1 : size;
+    }
+    
+    std::vector<ChunkResult> results(chunkCount);
+    if (chunkCount == 1) {
+        parseChunk(data, data + size, results[0]);
+    } else {
+        std::vector<std::future<void>> pending;
+        for (size_t i = 0; i < chunkCount; i++) {
+            pending.push_back(ThreadPool::shared().submit([&, i]() {
+                parseChunk(data + bounds[i], data + bounds[i + 1], results[i]);
+            }));
+        }
+        for (auto& f : pending) {
+            f.get();
+        }
+    }
+    
+    // 按块顺序合并，并把块内行号换算为文件行号
+    size_t total = students.size();
+    for (const auto& result : results) {
+        total += result.students.size();
+    }
+    students.reserve(total);
+    
+    int lineBase = 0;
+    for (auto& result : results) {
+        for (const auto& warning : result.warnings) {
+            std::cerr << "Warning: Line " << (lineBase + warning.first)
+                      << " has invalid format: " << warning.second << "\n";
+        }
+        std::move(result.students.begin(), result.students.end(), std::back_inserter(students));
+        lineBase += result.lineCount;
+    }
+    return true;
+}
+
+// 按文件内容识别格式读取数据文件
+bool FileStorage::readDataFile(const std::string& path, std::vector<Student>& students, uint64_t* sequence) {
+    if (BinaryFormat::isBinaryFile(path)) {
+        std::string error;
+        if (!BinaryFormat::load(path, students, error, sequence)) {
+            std::cerr << "Error: Cannot load " << path << ": " << error << "\n";
+            return false;
+        }
+        return true;
+    }
+    
+    if (!readTextFile(path, students)) {
+        std::cout << "Data file not found, will create a new one.\n";
+        return false;
+    }
+    if (sequence) {
+        *sequence = readTextSequence(path);
+    }
+    return true;
+}
+
+// 先写临时文件并 fsync，再原子地替换数据文件，保存中途崩溃不会损坏原文件
+bool FileStorage::saveStudents(const StudentView& students) {
+    uint64_t sequence = 0;
+    if (journal) {
+        journal->sync();
+        sequence = journal->lastSequence();
+    }
+    
+    std::string tempFile = dataFile + ".tmp";
+    if (format == DataFormat::Binary) {
+        std::string error;
+        if (!BinaryFormat::save(students, tempFile, error, sequence, true)) {
+            std::cerr << "Error: Cannot save " << dataFile << ": " << error << "\n";
+            return false;
+        }
+    } else if (!writeTextFile(students, tempFile, sequence, true)) {
+        return false;
+    }
+    
+    std::error_code ec;
+    fs::rename(tempFile, dataFile, ec);
+    if (ec) {
+        std::cerr << "Error: Cannot replace " << dataFile << ": " << ec.message() << "\n";
+        return false;
+    }
+    syncDirectory(dataDir);
+    snapshotSequence = sequence;
+    
+    // 快照已包含全部日志记录
+    if (journal) {
+        journal->truncate();
+    }
+    
+    std::cout << "Data saved to " << dataFile << " (" << students.size() << " records)\n";
+    return true;
+}
+
+std::vector<Student> FileStorage::loadStudents() {
+    std::vector<Student> students;
+    
+    if (!fs::exists(dataFile)) {
+        std::cout << "Data file not found, will create a new one.\n";
+        return students;
+    }
+    
+    // 按文件内容识别格式，两种格式的数据文件都能直接载入
+    snapshotSequence = 0;
+    if (!readDataFile(dataFile, students, &snapshotSequence)) {
+        return students;
+    }
+    
+    std::cout << "Loaded " << students.size() << " student records from " << dataFile << "\n";
+    return students;
+}
+
+// 备份内存中的当前数据（含尚未写入快照、只在日志里的修改）与上次备份相比有变化的记录
+bool FileStorage::createBackup(const StudentView& students) {
+    BackupStore store((fs::path(dataDir) / "backups").string());
+    BackupInfo info;
+    std::string error;
+    if (!store.create(students, info, error)) {
+        std::cerr << "Backup failed: " << error << "\n";
+        return false;
+    }
+    
+    std::cout << "Data backed up to " << info.file << " (#" << info.id << ", "
+              << (info.full ? "full" : "incremental") << ": "
+              << info.changed << " changed, " << info.removed << " removed)\n";
+    return true;
+}
+
+std::vector<BackupInfo> FileStorage::listBackups() const {
+    return BackupStore((fs::path(dataDir) / "backups").string()).list();
+}
+
+std::vector<Student> FileStorage::restoreBackup(int backupId) {
+    std::vector<Student> students;
+    std::string error;
+    BackupStore store((fs::path(dataDir) / "backups").string());
+    if (!store.restore(backupId, students, error)) {
+        std::cerr << "Restore failed: " << error << "\n";
+        return students;
+    }
+    std::cout << "Restored " << students.size() << " student records from backup #" << backupId << "\n";
+    return students;
+}
+
+bool FileStorage::exportToCSV(const StudentView& students, const std::string& filename) {
+    BufferedWriter writer(BufferedWriter::DEFAULT_CAPACITY, students.size() >= BACKGROUND_WRITE_THRESHOLD);
+    if (!writer.open(filename)) {
+        std::cerr << "Error: Cannot create file " << filename << "\n";
+        return false;
+    }
+    
+    // CSV头部
+    writer.append(CSV_HEADER, sizeof(CSV_HEADER) - 1);
+    
+    // 数据行
+    for (const auto& student : students) {
+        appendCSVRow(writer.buffer(), student);
+        writer.commitIfFull();
+    }
+    
+    if (!writer.close()) {
+        std::cerr << "Error: Failed to write " << filename << "\n";
+        return false;
+    }
+    std::cout << "Data exported to " << filename << " (" << students.size() << " records)\n";
+    return true;
+}
+
+std::vector<Student> FileStorage::importFromCSV(const std::string& filename) {
+    std::vector<Student> students;
+    
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << "\n";
+        return students;
+    }
+    
+    std::string line;
+    int lineCount = 0;
+    
+    while (std::getline(file, line)) {
+        lineCount++;
+        
+        // 跳过空行和标题行
+        if (line.empty() || lineCount == 1) {
+            continue;
+        }
+        
+        try {
+            // CSV解析
+            std::istringstream iss(line);
+            std::vector<std::string> tokens;
+            std::string token;
+            
+            while (std::getline(iss, token, ',')) {
+                tokens.push_back(token);
+            }
+            
+            if (tokens.size() >= 15) {
+                Student student;
+                student.id = tokens[0];
+                student.name = tokens[1];
+                student.gender = tokens[2][0];
+                student.age = std::stoi(tokens[3]);
+                student.department = tokens[4];
+                student.major = tokens[5];
+                student.className = tokens[6];
+                student.math = std::stod(tokens[7]);
+                student.cpp = std::stod(tokens[8]);
+                student.english = std::stod(tokens[9]);
+                student.linearAlgebra = std::stod(tokens[10]);
+                student.political = std::stod(tokens[11]);
+                student.totalScore = std::stod(tokens[12]);
+                student.averageScore = std::stod(tokens[13]);
+                student.rank = std::stoi(tokens[14]);
+                student.calculateScores();
+                
+                students.push_back(student);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: Line " << lineCount << " import failed: " << e.what() << "\n";
+        }
+    }
+    
+    file.close();
+    std::cout << "Imported " << students.size() << " student records from " << filename << "\n";
+    return students;
+}
+
+bool FileStorage::exportToText(const StudentView& students, const std::string& filename) {
+    if (!writeTextFile(students, filename)) {
+        return false;
+    }
+    std::cout << "Data exported to " << filename << " (" << students.size() << " records)\n";
+    return true;
+}
+
+std::vector<Student> FileStorage::importFromText(const std::string& filename) {
+    std::vector<Student> students;
+    if (!readTextFile(filename, students)) {
+        std::cerr << "Error: Cannot open file " << filename << "\n";
+        return students;
+    }
+    std::cout << "Imported " << students.size() << " student records from " << filename << "\n";
+    return students;
+}
+
+// 文本 <-> 二进制互转，方向由源文件格式决定
+bool FileStorage::convertDataFile(const std::string& from, const std::string& to) {
+    std::vector<Student> students;
+    std::string error;
+    bool toText = BinaryFormat::isBinaryFile(from);
+    
+    if (toText) {
+        if (!BinaryFormat::load(from, students, error)) {
+            std::cerr << "Error: Cannot load " << from << ": " << error << "\n";
+            return false;
+        }
+        if (!writeTextFile(students, to)) {
+            return false;
+        }
+    } else {
+        if (!readTextFile(from, students)) {
+            std::cerr << "Error: Cannot open file " << from << "\n";
+            return false;
+        }
+        if (!BinaryFormat::save(students, to, error)) {
+            std::cerr << "Error: Cannot save " << to << ": " << error << "\n";
+            return false;
+        }
+    }
+    
+    std::cout << "Converted " << students.size() << " records from " << from << " to "
+              << to << " (" << (toText ? "text" : "binary") << ")\n";
+    return true;
+}
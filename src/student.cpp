@@ -1,9 +1,16 @@
 #include "student.hpp"
-#include <iostream>
+#include "student_view.hpp"
+#include "student_batch.hpp"
+#include "journal.hpp"
+#include "thread_pool.hpp"
+#include "query.hpp"
+#include "sort_keys.hpp"
+#include "compact_store.hpp"
+#include "memory_usage.hpp"
 #include <algorithm>
-#include <iomanip>
-#include <sstream>
 #include <cctype>
+#include <charconv>
+#include <stdexcept>
 
 // ==================== Student 类实现 ====================
 
@@ -25,197 +32,678 @@ void Student::calculateScores() {
     averageScore = totalScore / 5.0;
 }
 
+namespace {
+
+const size_t FIELD_COUNT = 15;
+const size_t PARALLEL_MIN_CHUNK = 1 << 16;   // 每段至少这么多条记录才值得分给其他线程
+const size_t RANK_TABLE_THRESHOLD = 8192;    // 超过时名次改为查表
+const size_t BULK_REBUILD_RATIO = 4;         // 批量改动数 × 该值 ≥ 记录数时整体重建索引
+
+void appendInt(std::string& out, int value) {
+    char buf[16];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, res.ptr);
+}
+
+// 与 std::fixed << std::setprecision(2) 的输出逐字节一致
+void appendFixed2(std::string& out, double value) {
+    char buf[352];  // 足够容纳任意 double 的定点表示
+    auto res = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::fixed, 2);
+    out.append(buf, res.ptr);
+}
+
+// 与 stoi/stod 一样跳过前导空白、忽略尾部多余字符
+std::string_view skipSpace(std::string_view token) {
+    size_t pos = 0;
+    while (pos < token.size() && std::isspace(static_cast<unsigned char>(token[pos]))) pos++;
+    token.remove_prefix(pos);
+    if (!token.empty() && token[0] == '+') token.remove_prefix(1);
+    return token;
+}
+
+bool parseInt(std::string_view token, int& value) {
+    token = skipSpace(token);
+    auto res = std::from_chars(token.data(), token.data() + token.size(), value);
+    return res.ec == std::errc();
+}
+
+bool parseDouble(std::string_view token, double& value) {
+    token = skipSpace(token);
+    auto res = std::from_chars(token.data(), token.data() + token.size(), value);
+    return res.ec == std::errc();
+}
+
+} // namespace
+
 // 转换为字符串（用于文件存储）
 std::string Student::toString() const {
-    std::ostringstream oss;
-    oss << id << "|" << name << "|" << gender << "|" << age << "|"
-        << department << "|" << major << "|" << className << "|"
-        << std::fixed << std::setprecision(2)
-        << math << "|" << cpp << "|" << english << "|"
-        << linearAlgebra << "|" << political << "|"
-        << totalScore << "|" << averageScore << "|" << rank;
-    return oss.str();
+    std::string out;
+    out.reserve(96);
+    appendTo(out);
+    return out;
 }
 
-// 从字符串解析
+// 按文本格式追加到 out 末尾
+void Student::appendTo(std::string& out) const {
+    out += id; out += '|';
+    out += name; out += '|';
+    out += gender; out += '|';
+    appendInt(out, age); out += '|';
+    out += department; out += '|';
+    out += major; out += '|';
+    out += className; out += '|';
+    appendFixed2(out, math); out += '|';
+    appendFixed2(out, cpp); out += '|';
+    appendFixed2(out, english); out += '|';
+    appendFixed2(out, linearAlgebra); out += '|';
+    appendFixed2(out, political); out += '|';
+    appendFixed2(out, totalScore); out += '|';
+    appendFixed2(out, averageScore); out += '|';
+    appendInt(out, rank);
+}
+
+// 从字符串解析（格式错误时抛出异常）
 Student Student::fromString(const std::string& str) {
     Student student;
-    std::istringstream iss(str);
-    std::string token;
-    std::vector<std::string> tokens;
-    
-    // 分割字符串
-    while (std::getline(iss, token, '|')) {
-        tokens.push_back(token);
-    }
-    
-    // 解析数据（至少需要15个字段）
-    if (tokens.size() >= 15) {
-        student.id = tokens[0];
-        student.name = tokens[1];
-        student.gender = tokens[2][0];
-        student.age = std::stoi(tokens[3]);
-        student.department = tokens[4];
-        student.major = tokens[5];
-        student.className = tokens[6];
-        student.math = std::stod(tokens[7]);
-        student.cpp = std::stod(tokens[8]);
-        student.english = std::stod(tokens[9]);
-        student.linearAlgebra = std::stod(tokens[10]);
-        student.political = std::stod(tokens[11]);
-        student.totalScore = std::stod(tokens[12]);
-        student.averageScore = std::stod(tokens[13]);
-        student.rank = std::stoi(tokens[14]);
+    const char* error = nullptr;
+    if (!parse(str, student, &error)) {
+        throw std::invalid_argument(error);
     }
-    
     return student;
 }
 
-// 显示学生信息
-void Student::display() const {
-    std::cout << "\n========== Student Information ==========\n";
-    std::cout << "Student ID: " << id << "\n";
-    std::cout << "Name: " << name << "\n";
-    std::cout << "Gender: " << (gender == 'M' ? "Male" : "Female") << "\n";
-    std::cout << "Age: " << age << "\n";
-    std::cout << "Department: " << department << "\n";
-    std::cout << "Major: " << major << "\n";
-    std::cout << "Class: " << className << "\n";
-    std::cout << "\n-------- Course Scores --------\n";
-    std::cout << "Advanced Math: " << math << "\n";
-    std::cout << "C++ Programming: " << cpp << "\n";
-    std::cout << "English: " << english << "\n";
-    std::cout << "Linear Algebra: " << linearAlgebra << "\n";
-    std::cout << "Political: " << political << "\n";
-    std::cout << "\n-------- Statistics --------\n";
-    std::cout << "Total Score: " << totalScore << "\n";
-    std::cout << "Average Score: " << averageScore << "\n";
-    std::cout << "Rank: " << rank << "\n";
-    std::cout << "=======================================\n";
+// 基于 string_view 的解析，直接写入 student 的各字段
+bool Student::parse(std::string_view str, Student& student, const char** error) {
+    std::string_view tokens[FIELD_COUNT];
+    size_t count = 0;
+    
+    // 分割字符串（至少需要15个字段，多余的忽略）
+    size_t start = 0;
+    while (count < FIELD_COUNT && start < str.size()) {
+        size_t end = str.find('|', start);
+        if (end == std::string_view::npos) end = str.size();
+        tokens[count++] = str.substr(start, end - start);
+        start = end + 1;
+    }
+    
+    if (count < FIELD_COUNT) {
+        if (error) *error = "expected 15 fields";
+        return false;
+    }
+    
+    bool ok = parseInt(tokens[3], student.age)
+           && parseDouble(tokens[7], student.math)
+           && parseDouble(tokens[8], student.cpp)
+           && parseDouble(tokens[9], student.english)
+           && parseDouble(tokens[10], student.linearAlgebra)
+           && parseDouble(tokens[11], student.political)
+           && parseDouble(tokens[12], student.totalScore)
+           && parseDouble(tokens[13], student.averageScore)
+           && parseInt(tokens[14], student.rank);
+    if (!ok) {
+        if (error) *error = "invalid numeric field";
+        return false;
+    }
+    
+    student.id.assign(tokens[0]);
+    student.name.assign(tokens[1]);
+    student.gender = tokens[2].empty() ? '\0' : tokens[2][0];
+    student.department.assign(tokens[4]);
+    student.major.assign(tokens[5]);
+    student.className.assign(tokens[6]);
+    return true;
+}
+
+// ==================== Status 实现 ====================
+
+Status Status::duplicateId(const std::string& id) {
+    return {DuplicateId, "Student ID " + id + " already exists"};
+}
+
+Status Status::notFound(const std::string& id) {
+    return {NotFound, "Student with ID " + id + " not found"};
 }
 
 // ==================== StudentManager 类实现 ====================
 
-// 更新所有学生的排名
+// 重建所有按下标组织的索引（students 重排后调用）
+void StudentManager::rebuildIndex() {
+    idIndex.clear();
+    idIndex.reserve(students.size());
+    scores.clear();
+    scores.reserve(students.size());
+    departmentIndex.clear();
+    majorIndex.clear();
+    classIndex.clear();
+    idTrigrams.clear();
+    nameTrigrams.clear();
+    for (size_t i = 0; i < students.size(); i++) {
+        // 学号重复时保留第一条，与顺序查找的结果一致
+        idIndex.emplace(students[i].id, i);
+        scores.push(students[i]);
+        secondaryInsert(i);
+    }
+}
+
+// 三元组索引中的过期条目过多时重建
+void StudentManager::rebuildTrigrams() {
+    idTrigrams.clear();
+    nameTrigrams.clear();
+    for (size_t i = 0; i < students.size(); i++) {
+        idTrigrams.insert(i, students[i].id);
+        nameTrigrams.insert(i, students[i].name);
+    }
+}
+
+// 维护二级索引
+void StudentManager::secondaryInsert(size_t slot) {
+    const Student& student = students[slot];
+    departmentIndex.insert(slot, student.department);
+    majorIndex.insert(slot, student.major);
+    classIndex.insert(slot, student.className);
+    idTrigrams.insert(slot, student.id);
+    nameTrigrams.insert(slot, student.name);
+}
+
+void StudentManager::secondaryErase(size_t slot) {
+    departmentIndex.erase(slot);
+    majorIndex.erase(slot);
+    classIndex.erase(slot);
+    idTrigrams.markStale();
+    nameTrigrams.markStale();
+}
+
+// students[from] 已移动到 students[to]
+void StudentManager::secondaryMove(size_t from, size_t to) {
+    const Student& student = students[to];
+    departmentIndex.move(from, to);
+    majorIndex.move(from, to);
+    classIndex.move(from, to);
+    idTrigrams.markStale();
+    nameTrigrams.markStale();
+    idTrigrams.insert(to, student.id);
+    nameTrigrams.insert(to, student.name);
+}
+
+// 重新建立排名索引并刷新所有名次（批量载入时调用）
 void StudentManager::updateRanks() {
-    if (students.empty()) return;
+    rankIndex.build(scores.data(ScoreColumns::AVERAGE), scores.size());
+    ranksDirty = true;
+    refreshRanks();
+}
+
+// 把排名索引中的名次写回 students，无需排序
+// 记录较多时先扫描出整张名次表，再分段并行查表赋值
+void StudentManager::refreshRanks() {
+    if (!ranksDirty) return;
     
-    // 按平均分降序排序
-    std::sort(students.begin(), students.end(),
-        [](const Student& a, const Student& b) {
-            return a.averageScore > b.averageScore;
+    if (students.size() < RANK_TABLE_THRESHOLD) {
+        for (auto& student : students) {
+            student.rank = rankIndex.rankOf(student.averageScore);
+        }
+    } else {
+        std::vector<int> table;
+        rankIndex.rankTable(table);
+        const double* averages = scores.data(ScoreColumns::AVERAGE);
+        ThreadPool::shared().parallelFor(students.size(), PARALLEL_MIN_CHUNK, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                students[i].rank = rankIndex.rankOf(averages[i], table);
+            }
         });
+    }
+    ranksDirty = false;
+}
+
+// 删除指定下标的学生：用末尾元素填补空位，O(1)
+void StudentManager::removeAt(size_t slot) {
+    idIndex.erase(students[slot].id);
+    rankIndex.erase(students[slot].averageScore);
+    secondaryErase(slot);
     
-    // 分配排名（处理并列情况）
-    int currentRank = 1;
-    for (size_t i = 0; i < students.size(); i++) {
-        if (i > 0 && students[i].averageScore < students[i-1].averageScore) {
-            currentRank = i + 1;
-        }
-        students[i].rank = currentRank;
+    size_t last = students.size() - 1;
+    if (slot != last) {
+        students[slot] = std::move(students[last]);
+        idIndex[students[slot].id] = slot;
+        scores.moveLastTo(slot);
+        secondaryMove(last, slot);
+    }
+    students.pop_back();
+    scores.popBack();
+    ranksDirty = true;
+    
+    if (idTrigrams.needsRebuild() || nameTrigrams.needsRebuild()) {
+        rebuildTrigrams();
+    }
+}
+
+// 在末尾追加一条记录并维护全部索引（调用方已检查学号）
+void StudentManager::appendRecord(const Student& student) {
+    students.push_back(student);
+    idIndex.emplace(student.id, students.size() - 1);
+    scores.push(student);
+    secondaryInsert(students.size() - 1);
+    rankIndex.insert(student.averageScore);
+    ranksDirty = true;
+}
+
+// 用新记录替换指定下标并维护全部索引（调用方已检查学号）
+void StudentManager::replaceAt(size_t slot, const Student& newStudent) {
+    Student& student = students[slot];
+    rankIndex.erase(student.averageScore);
+    secondaryErase(slot);
+    if (student.id != newStudent.id) {
+        idIndex.erase(student.id);
+        idIndex.emplace(newStudent.id, slot);
+    }
+    student = newStudent;
+    student.calculateScores();
+    rankIndex.insert(student.averageScore);
+    scores.set(slot, student);
+    secondaryInsert(slot);
+    ranksDirty = true;
+    
+    if (idTrigrams.needsRebuild() || nameTrigrams.needsRebuild()) {
+        rebuildTrigrams();
     }
 }
 
 // 添加学生
-bool StudentManager::addStudent(const Student& student) {
+Status StudentManager::addStudent(const Student& student) {
     // 检查学号是否重复
-    for (const auto& s : students) {
-        if (s.id == student.id) {
-            std::cout << "Error: Student ID " << student.id << " already exists!\n";
-            return false;
-        }
+    if (idIndex.count(student.id)) {
+        return Status::duplicateId(student.id);
     }
     
-    students.push_back(student);
-    updateRanks();
-    return true;
+    appendRecord(student);
+    
+    if (journal) journal->logAdd(student);
+    return {};
 }
 
 // 删除学生
-bool StudentManager::deleteStudent(const std::string& id) {
-    auto it = std::remove_if(students.begin(), students.end(),
-        [&](const Student& s) { return s.id == id; });
-    
-    if (it != students.end()) {
-        students.erase(it, students.end());
-        updateRanks();
-        return true;
+Status StudentManager::deleteStudent(const std::string& id) {
+    auto found = idIndex.find(id);
+    if (found == idIndex.end()) {
+        return Status::notFound(id);
     }
     
-    std::cout << "Error: Student with ID " << id << " not found!\n";
-    return false;
+    removeAt(found->second);
+    
+    if (journal) journal->logDelete(id);
+    return {};
 }
 
 // 修改学生信息
-bool StudentManager::updateStudent(const std::string& id, const Student& newStudent) {
-    for (auto& student : students) {
-        if (student.id == id) {
-            // 检查新学号是否与其他学生冲突
-            if (id != newStudent.id) {
-                for (const auto& s : students) {
-                    if (s.id == newStudent.id) {
-                        std::cout << "Error: Student ID " << newStudent.id << " already exists!\n";
-                        return false;
-                    }
+Status StudentManager::updateStudent(const std::string& id, const Student& newStudent) {
+    auto found = idIndex.find(id);
+    if (found == idIndex.end()) {
+        return Status::notFound(id);
+    }
+    
+    // 检查新学号是否与其他学生冲突
+    if (id != newStudent.id && idIndex.count(newStudent.id)) {
+        return Status::duplicateId(newStudent.id);
+    }
+    
+    size_t slot = found->second;
+    replaceAt(slot, newStudent);
+    
+    if (journal) journal->logUpdate(id, students[slot]);
+    return {};
+}
+
+// 批量修改：先整体校验，再一次性应用，最后只刷新一次名次、同步一次日志
+// atomic 为 true 时任一操作校验失败则整批不生效；否则跳过失败的操作
+BatchResult StudentManager::apply(const StudentBatch& batch, bool atomic) {
+    using Operation = StudentBatch::Operation;
+    const std::vector<Operation>& operations = batch.operations;
+    BatchResult result;
+    
+    // 校验：在现有学号集合之上叠加批内的增删，按顺序模拟
+    std::unordered_map<std::string, bool> overlay;
+    auto exists = [&](const std::string& id) {
+        auto found = overlay.find(id);
+        return found != overlay.end() ? found->second : idIndex.count(id) > 0;
+    };
+    std::vector<char> valid(operations.size(), 0);
+    for (size_t i = 0; i < operations.size(); i++) {
+        const Operation& op = operations[i];
+        Status status = StudentBatch::validate(op, exists);
+        if (status) {
+            if (op.kind != Operation::Add) overlay[op.id] = false;
+            if (op.kind != Operation::Delete) overlay[op.student.id] = true;
+            valid[i] = 1;
+        } else {
+            result.errors.push_back({i, std::move(status)});
+        }
+    }
+    if (atomic && !result.ok()) {
+        return result;
+    }
+    
+    size_t validCount = operations.size() - result.errors.size();
+    if (validCount == 0) {
+        return result;
+    }
+    
+    if (validCount * BULK_REBUILD_RATIO >= students.size()) {
+        // 改动占比大：只维护 students 与学号索引，结束后整体重建其余索引
+        // 删除同样用末尾元素填补，最终顺序与逐条应用一致
+        for (size_t i = 0; i < operations.size(); i++) {
+            if (!valid[i]) continue;
+            const Operation& op = operations[i];
+            if (op.kind == Operation::Add) {
+                students.push_back(op.student);
+                idIndex.emplace(op.id, students.size() - 1);
+            } else if (op.kind == Operation::Delete) {
+                auto found = idIndex.find(op.id);
+                size_t slot = found->second;
+                idIndex.erase(found);
+                size_t last = students.size() - 1;
+                if (slot != last) {
+                    students[slot] = std::move(students[last]);
+                    idIndex[students[slot].id] = slot;
                 }
+                students.pop_back();
+            } else {
+                auto found = idIndex.find(op.id);
+                size_t slot = found->second;
+                if (op.id != op.student.id) {
+                    idIndex.erase(found);
+                    idIndex.emplace(op.student.id, slot);
+                }
+                students[slot] = op.student;
+                students[slot].calculateScores();
+            }
+        }
+        rebuildIndex();
+        updateRanks();
+    } else {
+        for (size_t i = 0; i < operations.size(); i++) {
+            if (!valid[i]) continue;
+            const Operation& op = operations[i];
+            if (op.kind == Operation::Add) {
+                appendRecord(op.student);
+            } else if (op.kind == Operation::Delete) {
+                removeAt(idIndex.find(op.id)->second);
+            } else {
+                replaceAt(idIndex.find(op.id)->second, op.student);
             }
-            
-            student = newStudent;
-            student.calculateScores();
-            updateRanks();
-            return true;
         }
     }
+    result.applied = validCount;
     
-    std::cout << "Error: Student with ID " << id << " not found!\n";
-    return false;
+    if (journal) {
+        for (size_t i = 0; i < operations.size(); i++) {
+            if (!valid[i]) continue;
+            const Operation& op = operations[i];
+            if (op.kind == Operation::Add) {
+                journal->logAdd(op.student);
+            } else if (op.kind == Operation::Delete) {
+                journal->logDelete(op.id);
+            } else {
+                Student logged = op.student;
+                logged.calculateScores();
+                journal->logUpdate(op.id, logged);
+            }
+        }
+        journal->sync();
+    }
+    return result;
 }
 
 // 查找学生（按学号）
 Student* StudentManager::findStudent(const std::string& id) {
-    for (auto& student : students) {
-        if (student.id == id) {
-            return &student;
-        }
+    auto found = idIndex.find(id);
+    if (found == idIndex.end()) {
+        return nullptr;
     }
-    return nullptr;
+    Student& student = students[found->second];
+    student.rank = rankIndex.rankOf(student.averageScore);
+    return &student;
 }
 
-// 获取所有学生
+// 只读查找：不写回名次，可在共享锁下并发调用
+const Student* StudentManager::findStudent(const std::string& id) const {
+    auto found = idIndex.find(id);
+    return found == idIndex.end() ? nullptr : &students[found->second];
+}
+
+// 全部学生的视图
+StudentView StudentManager::view() {
+    refreshRanks();
+    return StudentView(students);
+}
+
+// 获取所有学生（拷贝）
 std::vector<Student> StudentManager::getAllStudents() const {
-    return students;
+    std::vector<Student> result = students;
+    if (ranksDirty) {
+        for (auto& student : result) {
+            student.rank = rankIndex.rankOf(student.averageScore);
+        }
+    }
+    return result;
+}
+
+// 查询学生名次，不存在时返回 0
+int StudentManager::getRank(const std::string& id) const {
+    auto found = idIndex.find(id);
+    if (found == idIndex.end()) {
+        return 0;
+    }
+    return rankIndex.rankOf(students[found->second].averageScore);
+}
+
+// 获取前 k 名（并列者一并返回），按平均分降序
+StudentView StudentManager::getTopStudents(size_t k) {
+    auto slots = std::make_shared<std::vector<uint32_t>>();
+    if (k == 0 || students.empty()) {
+        return StudentView(students.data(), slots);
+    }
+    refreshRanks();
+    
+    // 由排名索引直接得到第 k 名的分数线，只需一次筛选
+    double threshold = rankIndex.kthScore(std::min(k, students.size()));
+    for (uint32_t i = 0; i < students.size(); i++) {
+        if (students[i].averageScore >= threshold) {
+            slots->push_back(i);
+        }
+    }
+    
+    // 名次相同按存储顺序，结果与调用时机无关
+    std::sort(slots->begin(), slots->end(), [this](uint32_t a, uint32_t b) {
+        int rankA = students[a].rank, rankB = students[b].rank;
+        return rankA != rankB ? rankA < rankB : a < b;
+    });
+    return StudentView(students.data(), slots);
+}
+
+// 大小为 k 的堆选择，O(n log k)；不带过滤的平均分查询先用排名索引求出分数线，
+// 只有线内的记录进入堆
+StudentView StudentManager::selectTop(ScoreColumns::Column column, size_t k, bool highest,
+                                      const Query* filter) {
+    refreshRanks();
+    auto slots = std::make_shared<std::vector<uint32_t>>();
+    if (k == 0 || students.empty()) {
+        return StudentView(students.data(), slots);
+    }
+    
+    const double* values = scores.data(column);
+    // better(a, b)：a 排在 b 之前；堆顶是已选中里最差的一条
+    auto better = [values, highest](uint32_t a, uint32_t b) {
+        if (values[a] != values[b]) {
+            return highest ? values[a] > values[b] : values[a] < values[b];
+        }
+        return a < b;
+    };
+    
+    std::vector<uint32_t>& heap = *slots;
+    heap.reserve(std::min(k, students.size()));
+    auto offer = [&](uint32_t slot) {
+        if (heap.size() < k) {
+            heap.push_back(slot);
+            std::push_heap(heap.begin(), heap.end(), better);
+        } else if (better(slot, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), better);
+            heap.back() = slot;
+            std::push_heap(heap.begin(), heap.end(), better);
+        }
+    };
+    
+    if (filter) {
+        CompiledQuery compiled = filter->compile();
+        for (uint32_t slot : selectSlots(compiled)) {
+            offer(slot);
+        }
+    } else if (column == ScoreColumns::AVERAGE && k < students.size()) {
+        size_t n = students.size();
+        double threshold = rankIndex.kthScore(highest ? k : n - k + 1);
+        for (uint32_t slot = 0; slot < n; slot++) {
+            if (highest ? values[slot] >= threshold : values[slot] <= threshold) {
+                offer(slot);
+            }
+        }
+    } else {
+        for (uint32_t slot = 0; slot < students.size(); slot++) {
+            offer(slot);
+        }
+    }
+    
+    std::sort_heap(heap.begin(), heap.end(), better);
+    return StudentView(students.data(), slots);
+}
+
+// 按条件查询匹配的下标（升序）
+// 学号、姓名：子串长度 >= 3 时用三元组索引取候选再回表校验，否则顺序扫描
+// 院系、专业、班级：取值种类很少，只需在索引的各个取值上做子串匹配再合并下标列表
+std::vector<uint32_t> StudentManager::matchSlots(const std::string& field, const std::string& value) const {
+    std::vector<uint32_t> slots;
+    
+    if (field == "id" || field == "name") {
+        bool byId = field == "id";
+        const TrigramIndex& trigrams = byId ? idTrigrams : nameTrigrams;
+        auto matches = [&](uint32_t i) {
+            const std::string& text = byId ? students[i].id : students[i].name;
+            return text.find(value) != std::string::npos;
+        };
+        
+        if (TrigramIndex::usable(value)) {
+            for (uint32_t i : trigrams.candidates(value)) {
+                if (i < students.size() && matches(i)) slots.push_back(i);
+            }
+        } else {
+            for (uint32_t i = 0; i < students.size(); i++) {
+                if (matches(i)) slots.push_back(i);
+            }
+        }
+        return slots;
+    }
+    
+    const CategoryIndex* index = nullptr;
+    if (field == "department") {
+        index = &departmentIndex;
+    } else if (field == "major") {
+        index = &majorIndex;
+    } else if (field == "class") {
+        index = &classIndex;
+    } else {
+        return slots;
+    }
+    
+    const InternTable& values = index->values();
+    for (uint32_t id = 0; id < values.size(); id++) {
+        const std::vector<uint32_t>* list = index->find(id);
+        if (list && values.name(id).find(value) != std::string::npos) {
+            slots.insert(slots.end(), list->begin(), list->end());
+        }
+    }
+    std::sort(slots.begin(), slots.end());
+    return slots;
 }
 
 // 按条件查询学生
-std::vector<Student> StudentManager::findStudentsByCondition(
+StudentView StudentManager::findStudentsByCondition(
     const std::string& field, const std::string& value) {
+    refreshRanks();
+    return StudentView(students.data(),
+                       std::make_shared<std::vector<uint32_t>>(matchSlots(field, value)));
+}
+
+// 为编译后的查询挑选候选下标：顶层 AND 中若有可走索引的谓词，取最小的候选集，
+// 否则全表扫描；候选记录再用完整的谓词程序校验，分类字段的等值谓词先绑定为整数比较
+std::vector<uint32_t> StudentManager::selectSlots(CompiledQuery& compiled) const {
+    compiled.bindCategory(Query::Field::Department, departmentIndex);
+    compiled.bindCategory(Query::Field::Major, majorIndex);
+    compiled.bindCategory(Query::Field::ClassName, classIndex);
     
-    std::vector<Student> result;
+    std::vector<uint32_t> candidates;
+    bool indexed = false;
     
-    for (const auto& student : students) {
-        bool match = false;
-        
-        if (field == "id") {
-            match = (student.id.find(value) != std::string::npos);
-        } else if (field == "name") {
-            match = (student.name.find(value) != std::string::npos);
-        } else if (field == "department") {
-            match = (student.department.find(value) != std::string::npos);
-        } else if (field == "major") {
-            match = (student.major.find(value) != std::string::npos);
-        } else if (field == "class") {
-            match = (student.className.find(value) != std::string::npos);
+    auto offer = [&](std::vector<uint32_t>&& slots) {
+        if (!indexed || slots.size() < candidates.size()) {
+            candidates = std::move(slots);
+            indexed = true;
         }
+    };
+    
+    for (const auto& p : compiled.conjuncts()) {
+        if (indexed && candidates.empty()) break;
         
-        if (match) {
-            result.push_back(student);
+        if (p.op == Query::Op::Eq) {
+            const CategoryIndex* index = nullptr;
+            switch (p.field) {
+                case Query::Field::Department: index = &departmentIndex; break;
+                case Query::Field::Major: index = &majorIndex; break;
+                case Query::Field::ClassName: index = &classIndex; break;
+                case Query::Field::Id: {
+                    auto found = idIndex.find(p.text);
+                    std::vector<uint32_t> slots;
+                    if (found != idIndex.end()) slots.push_back(static_cast<uint32_t>(found->second));
+                    offer(std::move(slots));
+                    break;
+                }
+                default: break;
+            }
+            if (index) {
+                const std::vector<uint32_t>* list = index->find(p.text);
+                if (!list) {
+                    offer({});
+                } else if (!indexed || list->size() < candidates.size()) {
+                    offer(std::vector<uint32_t>(list->begin(), list->end()));
+                }
+            }
+        } else if (p.op == Query::Op::Contains && TrigramIndex::usable(p.text)) {
+            if (p.field == Query::Field::Id) {
+                offer(idTrigrams.candidates(p.text));
+            } else if (p.field == Query::Field::Name) {
+                offer(nameTrigrams.candidates(p.text));
+            }
         }
     }
     
+    std::vector<uint32_t> result;
+    if (indexed) {
+        std::sort(candidates.begin(), candidates.end());
+        for (uint32_t slot : candidates) {
+            if (slot < students.size() && compiled.matches(students[slot], slot)) result.push_back(slot);
+        }
+    } else {
+        for (uint32_t slot = 0; slot < students.size(); slot++) {
+            if (compiled.matches(students[slot], slot)) result.push_back(slot);
+        }
+    }
     return result;
 }
 
-// 获取统计信息
+// 组合查询
+StudentView StudentManager::query(const Query& query) {
+    CompiledQuery compiled = query.compile();
+    refreshRanks();
+    return StudentView(students.data(), std::make_shared<std::vector<uint32_t>>(selectSlots(compiled)));
+}
+
+// 获取统计信息（基于列式成绩和向量化内核）
 StudentManager::Statistics StudentManager::getStatistics() const {
     Statistics stats = {0};
     stats.totalStudents = students.size();
@@ -224,79 +712,203 @@ StudentManager::Statistics StudentManager::getStatistics() const {
         return stats;
     }
     
-    double totalMath = 0, totalCpp = 0, totalEnglish = 0;
-    double totalLinearAlgebra = 0, totalPolitical = 0;
-    double totalOverall = 0;
+    size_t n = scores.size();
+    stats.avgMath = ScoreKernels::sum(scores.data(ScoreColumns::MATH), n) / n;
+    stats.avgCpp = ScoreKernels::sum(scores.data(ScoreColumns::CPP), n) / n;
+    stats.avgEnglish = ScoreKernels::sum(scores.data(ScoreColumns::ENGLISH), n) / n;
+    stats.avgLinearAlgebra = ScoreKernels::sum(scores.data(ScoreColumns::LINEAR_ALGEBRA), n) / n;
+    stats.avgPolitical = ScoreKernels::sum(scores.data(ScoreColumns::POLITICAL), n) / n;
+    stats.overallAverage = ScoreKernels::sum(scores.data(ScoreColumns::AVERAGE), n) / n;
     
-    for (const auto& student : students) {
-        totalMath += student.math;
-        totalCpp += student.cpp;
-        totalEnglish += student.english;
-        totalLinearAlgebra += student.linearAlgebra;
-        totalPolitical += student.political;
-        totalOverall += student.averageScore;
-        
-        if (student.averageScore >= 60.0) {
-            stats.passCount++;
-        } else {
-            stats.failCount++;
-        }
-    }
-    
-    stats.avgMath = totalMath / students.size();
-    stats.avgCpp = totalCpp / students.size();
-    stats.avgEnglish = totalEnglish / students.size();
-    stats.avgLinearAlgebra = totalLinearAlgebra / students.size();
-    stats.avgPolitical = totalPolitical / students.size();
-    stats.overallAverage = totalOverall / students.size();
+    stats.passCount = ScoreKernels::countAtLeast(scores.data(ScoreColumns::AVERAGE), n, 60.0);
+    stats.failCount = stats.totalStudents - stats.passCount;
     
     return stats;
 }
 
-// 显示不及格学生
-void StudentManager::showFailingStudents() const {
-    std::cout << "\n========== Failing Students ==========\n";
-    bool hasFailing = false;
+namespace {
+
+// 单个分组的累加器
+struct GroupAccumulator {
+    double sums[ScoreColumns::COLUMN_COUNT] = {0};
+    int count = 0;
+    int passCount = 0;
+};
+
+} // namespace
+
+// 按院系/专业/班级分组统计，单次扫描；数据量大时分段并行后合并
+std::vector<StudentManager::GroupStatistics> StudentManager::getGroupedStatistics(
+    const std::string& field) const {
     
-    for (const auto& student : students) {
-        if (student.averageScore < 60.0) {
-            std::cout << "ID: " << student.id 
-                     << ", Name: " << student.name
-                     << ", Average: " << student.averageScore << "\n";
-            hasFailing = true;
+    const CategoryIndex* index = nullptr;
+    if (field == "department") {
+        index = &departmentIndex;
+    } else if (field == "major") {
+        index = &majorIndex;
+    } else if (field == "class") {
+        index = &classIndex;
+    } else {
+        return {};
+    }
+    
+    // 分组键就是驻留编号，累加器按编号直接寻址，不再对字符串求哈希
+    const uint32_t* ids = index->ids();
+    size_t groupCount = index->values().size();
+    const double* columns[ScoreColumns::COLUMN_COUNT];
+    for (int c = 0; c < ScoreColumns::COLUMN_COUNT; c++) {
+        columns[c] = scores.data(static_cast<ScoreColumns::Column>(c));
+    }
+    
+    auto aggregate = [&](size_t begin, size_t end, std::vector<GroupAccumulator>& partial) {
+        partial.resize(groupCount);
+        for (size_t i = begin; i < end; i++) {
+            GroupAccumulator& group = partial[ids[i]];
+            for (int c = 0; c < ScoreColumns::COLUMN_COUNT; c++) {
+                group.sums[c] += columns[c][i];
+            }
+            group.count++;
+            group.passCount += columns[ScoreColumns::AVERAGE][i] >= 60.0;
+        }
+    };
+    
+    // 每段至少 64k 条记录才值得并行
+    ThreadPool& pool = ThreadPool::shared();
+    size_t chunkCount = std::max<size_t>(1, std::min(pool.size(), students.size() / PARALLEL_MIN_CHUNK));
+    std::vector<std::vector<GroupAccumulator>> partials(chunkCount);
+    
+    if (chunkCount == 1) {
+        aggregate(0, students.size(), partials[0]);
+    } else {
+        size_t step = (students.size() + chunkCount - 1) / chunkCount;
+        std::vector<std::future<void>> pending;
+        for (size_t c = 0; c < chunkCount; c++) {
+            size_t begin = c * step;
+            size_t end = std::min(students.size(), begin + step);
+            pending.push_back(pool.submit([&, c, begin, end]() { aggregate(begin, end, partials[c]); }));
+        }
+        for (auto& f : pending) {
+            f.get();
+        }
+    }
+    
+    // 合并各段结果
+    std::vector<GroupAccumulator>& merged = partials[0];
+    for (size_t p = 1; p < partials.size(); p++) {
+        for (size_t g = 0; g < groupCount; g++) {
+            GroupAccumulator& target = merged[g];
+            const GroupAccumulator& source = partials[p][g];
+            for (int c = 0; c < ScoreColumns::COLUMN_COUNT; c++) {
+                target.sums[c] += source.sums[c];
+            }
+            target.count += source.count;
+            target.passCount += source.passCount;
         }
     }
     
-    if (!hasFailing) {
-        std::cout << "All students have passed!\n";
+    // 按键排序输出，跳过已经没有记录的取值
+    std::vector<uint32_t> byName(groupCount);
+    std::vector<uint32_t> order = index->values().sortedOrder();
+    for (uint32_t id = 0; id < groupCount; id++) {
+        byName[order[id]] = id;
+    }
+    
+    std::vector<GroupStatistics> result;
+    for (uint32_t id : byName) {
+        const GroupAccumulator& group = merged[id];
+        if (group.count == 0) continue;
+        GroupStatistics item;
+        item.key = index->values().name(id);
+        item.stats.totalStudents = group.count;
+        item.stats.avgMath = group.sums[ScoreColumns::MATH] / group.count;
+        item.stats.avgCpp = group.sums[ScoreColumns::CPP] / group.count;
+        item.stats.avgEnglish = group.sums[ScoreColumns::ENGLISH] / group.count;
+        item.stats.avgLinearAlgebra = group.sums[ScoreColumns::LINEAR_ALGEBRA] / group.count;
+        item.stats.avgPolitical = group.sums[ScoreColumns::POLITICAL] / group.count;
+        item.stats.overallAverage = group.sums[ScoreColumns::AVERAGE] / group.count;
+        item.stats.passCount = group.passCount;
+        item.stats.failCount = group.count - group.passCount;
+        result.push_back(std::move(item));
     }
-    std::cout << "====================================\n";
+    return result;
+}
+
+// 平均分不及格的学生，按存储顺序
+StudentView StudentManager::getFailingStudents() {
+    refreshRanks();
+    auto slots = std::make_shared<std::vector<uint32_t>>();
+    const double* averages = scores.data(ScoreColumns::AVERAGE);
+    for (uint32_t i = 0; i < students.size(); i++) {
+        if (averages[i] < 60.0) {
+            slots->push_back(i);
+        }
+    }
+    return StudentView(students.data(), slots);
 }
 
 // 按条件排序
 void StudentManager::sortStudents(const std::string& by, bool ascending) {
+    SortKey key;
+    key.ascending = ascending;
     if (by == "id") {
-        std::sort(students.begin(), students.end(),
-            [ascending](const Student& a, const Student& b) {
-                return ascending ? (a.id < b.id) : (a.id > b.id);
-            });
+        key.field = Query::Field::Id;
     } else if (by == "name") {
-        std::sort(students.begin(), students.end(),
-            [ascending](const Student& a, const Student& b) {
-                return ascending ? (a.name < b.name) : (a.name > b.name);
-            });
+        key.field = Query::Field::Name;
     } else if (by == "score") {
-        std::sort(students.begin(), students.end(),
-            [ascending](const Student& a, const Student& b) {
-                return ascending ? (a.averageScore < b.averageScore) 
-                                 : (a.averageScore > b.averageScore);
-            });
+        key.field = Query::Field::Average;
+    } else {
+        return;
     }
+    sortStudents(std::vector<SortKey>{key});
+}
+
+// 按预先算好的排序键对下标排列排序，每条记录只移动一次
+void StudentManager::sortStudents(const std::vector<SortKey>& keys) {
+    refreshRanks();
     
-    // 如果按分数排序，需要重新计算排名
-    if (by == "score") {
-        updateRanks();
+    std::vector<SortKeys::InternedColumn> interned = {
+        {Query::Field::Department, departmentIndex.ids(), &departmentIndex.values()},
+        {Query::Field::Major, majorIndex.ids(), &majorIndex.values()},
+        {Query::Field::ClassName, classIndex.ids(), &classIndex.values()},
+    };
+    std::vector<uint32_t> order = SortKeys::order(students, keys, interned);
+    std::vector<Student> sorted;
+    sorted.reserve(students.size());
+    for (uint32_t slot : order) {
+        sorted.push_back(std::move(students[slot]));
     }
+    students.swap(sorted);
+    
+    // 排序改变了下标，同步索引
+    rebuildIndex();
+}
+
+// 统计当前名册及各索引的内存占用，并估算改用紧凑存储后的占用
+StudentManager::MemoryReport StudentManager::getMemoryReport() const {
+    MemoryReport report;
+    report.records = students.size();
+    report.recordBytes = MemoryUsage::heapBytes(students);
+    
+    for (const auto& student : students) {
+        for (const std::string* field : {&student.id, &student.name, &student.department,
+                                         &student.major, &student.className}) {
+            report.stringHeapBytes += MemoryUsage::heapBytes(*field);
+        }
+    }
+    
+    report.indexBytes = MemoryUsage::hashTableBytes(idIndex) + scores.memoryUsage() + rankIndex.memoryUsage()
+                      + departmentIndex.memoryUsage() + majorIndex.memoryUsage() + classIndex.memoryUsage()
+                      + idTrigrams.memoryUsage() + nameTrigrams.memoryUsage();
+    for (const auto& entry : idIndex) {
+        report.indexBytes += MemoryUsage::heapBytes(entry.first);
+    }
+    
+    // 按每条记录的大小估算，不另建一份紧凑存储
+    auto compact = CompactStudentStore::estimate(students, departmentIndex.values(), majorIndex.values(),
+                                                 classIndex.values());
+    report.compactEstimateBytes = compact.bytes;
+    report.compactEstimateExceptions = compact.exceptions;
+    return report;
 }
 
 // 获取学生数量
@@ -307,10 +919,26 @@ size_t StudentManager::getCount() const {
 // 清空所有数据
 void StudentManager::clear() {
     students.clear();
+    idIndex.clear();
+    scores.clear();
+    departmentIndex.clear();
+    majorIndex.clear();
+    classIndex.clear();
+    idTrigrams.clear();
+    nameTrigrams.clear();
+    rankIndex.clear();
+    ranksDirty = false;
+    
+    if (journal) journal->logClear();
 }
 
 // 设置学生列表
 void StudentManager::setStudents(const std::vector<Student>& newStudents) {
     students = newStudents;
+    rebuildIndex();
     updateRanks();
+}
+
+void StudentManager::setJournal(Journal* newJournal) {
+    journal = newJournal;
 }
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "student_batch.hpp"
+
+// ==================== StudentBatch 类实现 ====================
+
+void StudentBatch::add(const Student& student) {
+    operations.push_back({Operation::Add, student.id, student});
+}
+
+void StudentBatch::remove(const std::string& id) {
+    operations.push_back({Operation::Delete, id, Student()});
+}
+
+void StudentBatch::update(const std::string& id, const Student& student) {
+    operations.push_back({Operation::Update, id, student});
+}
@@ -0,0 +1,66 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threadCount) : stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t minChunk, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return;
+    
+    size_t chunks = std::min(workers.size(), (count + minChunk - 1) / std::max<size_t>(minChunk, 1));
+    if (chunks <= 1) {
+        fn(0, count);
+        return;
+    }
+    
+    // 第一段在调用线程上执行，其余段交给线程池
+    size_t step = (count + chunks - 1) / chunks;
+    std::vector<std::future<void>> pending;
+    for (size_t begin = step; begin < count; begin += step) {
+        size_t end = std::min(count, begin + step);
+        pending.push_back(submit([&fn, begin, end]() { fn(begin, end); }));
+    }
+    fn(0, std::min(count, step));
+    for (auto& f : pending) {
+        f.get();
+    }
+}
@@ -0,0 +1,190 @@
+// 备份自检：在 修改 -> 备份 的各个阶段检查每次备份恢复出的数据与备份时内存中的数据一致，
+// 包括只写入日志、尚未保存快照的修改，以及哈希表、manifest 损坏的情况；全部通过时返回 0
+//   sms_backup_check
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include "journal.hpp"
+#include "storage.hpp"
+#include "student.hpp"
+#include "student_view.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        failures++;
+        std::cerr << "FAIL " << what << "\n";
+    }
+}
+
+// 一次进程运行：与 main.cpp 的 loadData 相同，载入快照并重放日志
+struct Session {
+    FileStorage storage;
+    Journal journal;
+    StudentManager manager;
+    
+    explicit Session(const std::string& dataFile) {
+        storage.setDataFile(dataFile);
+        manager.setStudents(storage.loadStudents());
+        if (journal.open(dataFile + ".journal", storage.getSnapshotSequence())) {
+            journal.replay(manager, storage.getSnapshotSequence());
+            manager.setJournal(&journal);
+            storage.setJournal(&journal);
+        }
+    }
+    
+    bool save() { return storage.saveStudents(manager.view()); }
+    bool backup() { return storage.createBackup(manager.view()); }
+};
+
+Student makeStudent(const std::string& id, double score) {
+    Student student(id, "Student " + id, 'M', 20);
+    student.department = "Math";
+    student.major = "Statistics";
+    student.className = "ST01";
+    student.math = student.cpp = student.english = student.linearAlgebra = student.political = score;
+    student.calculateScores();
+    return student;
+}
+
+// 学号 -> 记录文本（去掉名次，名次由整体数据派生）
+using Contents = std::map<std::string, std::string>;
+
+Contents contentsOf(const StudentView& students) {
+    Contents contents;
+    std::string line;
+    for (const auto& student : students) {
+        line.clear();
+        student.appendTo(line);
+        contents[student.id] = line.substr(0, line.rfind('|'));
+    }
+    return contents;
+}
+
+struct Expected {
+    Contents contents;
+    size_t changed;
+    size_t removed;
+    bool full;
+};
+
+void runScenario(const fs::path& directory, const std::string& fileName) {
+    const std::string dataFile = (directory / fileName).string();
+    const std::string label = fileName + ": ";
+    std::map<int, Contents> taken;  // 备份号 -> 备份时的数据
+    auto restart = [&](std::unique_ptr<Session>& session) {
+        session.reset();
+        session.reset(new Session(dataFile));
+    };
+    auto backup = [&](Session& session, const Expected& expected, const std::string& step) {
+        check(contentsOf(session.manager.view()) == expected.contents, label + step + ": roster");
+        check(session.backup(), label + step + ": backup");
+        auto backups = session.storage.listBackups();
+        if (backups.empty()) {
+            check(false, label + step + ": manifest");
+            return;
+        }
+        const BackupInfo& info = backups.back();
+        check(info.full == expected.full, label + step + ": backup type");
+        check(info.changed == expected.changed && info.removed == expected.removed,
+              label + step + ": expected " + std::to_string(expected.changed) + " changed, "
+              + std::to_string(expected.removed) + " removed, found " + std::to_string(info.changed)
+              + ", " + std::to_string(info.removed));
+        taken[info.id] = expected.contents;
+    };
+    
+    std::unique_ptr<Session> session(new Session(dataFile));
+    session->manager.addStudent(makeStudent("S1", 60));
+    check(session->save(), label + "snapshot");
+    Contents contents = contentsOf(session->manager.view());
+    backup(*session, {contents, 1, 0, true}, "first backup");
+    
+    // 重启后只写入日志的修改也要进入备份
+    restart(session);
+    session->manager.addStudent(makeStudent("S2", 70));
+    contents = contentsOf(session->manager.view());
+    backup(*session, {contents, 1, 0, false}, "journal-only add");
+    
+    // 修改与删除；名次变化不算修改
+    session->manager.updateStudent("S1", makeStudent("S1", 95));
+    session->manager.addStudent(makeStudent("S3", 50));
+    session->manager.deleteStudent("S2");
+    contents = contentsOf(session->manager.view());
+    backup(*session, {contents, 2, 1, false}, "update and delete");
+    
+    // 没有变化的备份
+    restart(session);
+    backup(*session, {contents, 0, 0, false}, "unchanged");
+    
+    // 清空全部数据
+    for (const auto& entry : contents) {
+        session->manager.deleteStudent(entry.first);
+    }
+    backup(*session, {Contents(), 0, contents.size(), false}, "all deleted");
+    
+    // 达到全量备份间隔后改做全量备份
+    int count = static_cast<int>(taken.size());
+    for (int i = count; i < BackupStore::FULL_BACKUP_INTERVAL; i++) {
+        session->manager.addStudent(makeStudent("T" + std::to_string(i), i));
+        contents = contentsOf(session->manager.view());
+        backup(*session, {contents, 1, 0, false}, "incremental " + std::to_string(i + 1));
+    }
+    backup(*session, {contents, contents.size(), 0, true}, "full after interval");
+    
+    // 哈希表有损坏的行时改做全量备份
+    session->manager.addStudent(makeStudent("U1", 88));
+    contents = contentsOf(session->manager.view());
+    {
+        std::ofstream hashes(directory / "backups" / "hashes.txt", std::ios::app);
+        hashes << "T1|not-a-hash\n";
+    }
+    backup(*session, {contents, contents.size(), 0, true}, "corrupt hashes");
+    
+    // manifest 中损坏的行被跳过，其余备份照常列出，后续备份接着编号
+    {
+        std::ofstream manifest(directory / "backups" / "manifest.txt", std::ios::app);
+        manifest << "99|2026-01-01 00:00:00|I|many|0|backup_99.txt\n";
+    }
+    check(session->storage.listBackups().size() == taken.size(), label + "corrupt manifest line skipped");
+    session->manager.deleteStudent("U1");
+    contents = contentsOf(session->manager.view());
+    backup(*session, {contents, 0, 1, false}, "after corrupt manifest line");
+    
+    // 每一次备份都能恢复出备份时的数据
+    for (const auto& entry : taken) {
+        std::vector<Student> restored = session->storage.restoreBackup(entry.first);
+        check(contentsOf(restored) == entry.second, label + "restore #" + std::to_string(entry.first));
+    }
+}
+
+} // namespace
+
+int main() {
+    fs::path directory = fs::temp_directory_path()
+        / ("sms_backup_check_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    
+    // 文本和二进制数据文件各用一个目录，备份目录互不影响
+    fs::create_directories(directory / "text");
+    fs::create_directories(directory / "binary");
+    runScenario(directory / "text", "students.txt");
+    runScenario(directory / "binary", "students.bin");
+    
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+    
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "All backup checks passed\n";
+    return 0;
+}
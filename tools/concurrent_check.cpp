@@ -0,0 +1,199 @@
+// 并发管理自检：随机增删改与批量操作同时作用于 StudentManager 和 ConcurrentStudentManager，
+// 每步比较两者的记录、名次和组合查询结果（含走索引的等值查询）；较大的一组数据使下标列表
+// 跨越多个块、排名增量超过上限而并入基础索引。再让多个读者线程在写者
+// 持续发布新版本时检查快照自身的一致性。全部通过时返回 0
+//   sms_concurrent_check
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "concurrent_manager.hpp"
+#include "query.hpp"
+#include "student.hpp"
+#include "student_batch.hpp"
+#include "student_view.hpp"
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition && ++failures <= 20) {
+        std::cerr << "FAIL " << what << "\n";
+    }
+}
+
+Student randomStudent(std::mt19937& rng, int idRange, bool fineScores = false) {
+    Student student("S" + std::to_string(rng() % idRange), "Name" + std::to_string(rng() % 50),
+                    rng() % 2 ? 'M' : 'F', 18 + static_cast<int>(rng() % 6));
+    student.department = "D" + std::to_string(rng() % 4);
+    student.major = "M" + std::to_string(rng() % 7);
+    student.className = "C" + std::to_string(rng() % 12);
+    double* fields[] = {&student.math, &student.cpp, &student.english, &student.linearAlgebra, &student.political};
+    for (double* field : fields) {
+        // 默认分数取值少，制造并列名次；fineScores 时取两位小数，平均分几乎各不相同
+        *field = fineScores ? static_cast<double>(rng() % 10001) / 100.0 : static_cast<double>(rng() % 41) * 2.5;
+    }
+    student.calculateScores();
+    return student;
+}
+
+const char* QUERIES[] = {
+    "department = D1",
+    "major = M2 and average >= 60",
+    "class = C3 and department = D0",
+    "id = S5",
+    "id = S5 and major = M1",
+    "department = Nope",
+    "class = C4 or math < 30",
+    "rank <= 10 and department = D2",
+    "name contains 1",
+    "not department = D3 and english > 50",
+};
+
+void compareState(StudentManager& reference, const ConcurrentStudentManager& concurrent, const std::string& step) {
+    auto snapshot = concurrent.snapshot();
+    StudentView all = reference.view();
+    check(snapshot->size() == all.size(), step + ": size");
+    if (snapshot->size() != all.size()) return;
+    
+    for (size_t i = 0; i < all.size(); i++) {
+        const Student& expected = all[i];
+        const Student& actual = (*snapshot)[i];
+        // 快照记录中的 rank 字段不维护，比较时去掉
+        std::string expectedText = expected.toString();
+        std::string actualText = actual.toString();
+        check(actualText.compare(0, actualText.rfind('|'), expectedText, 0, expectedText.rfind('|')) == 0,
+              step + ": record " + expected.id);
+        check(snapshot->rankOf(actual) == expected.rank, step + ": rank of " + expected.id);
+        check(snapshot->find(expected.id) == &actual, step + ": find " + expected.id);
+    }
+    
+    for (const char* text : QUERIES) {
+        Query query;
+        std::string error;
+        Query::parse(text, query, error);
+        StudentView matched = reference.query(query);
+        std::vector<const Student*> selected = snapshot->select(query);
+        bool same = matched.size() == selected.size();
+        for (size_t i = 0; same && i < selected.size(); i++) {
+            same = matched[i].id == selected[i]->id;
+        }
+        check(same, step + ": query \"" + text + "\"");
+    }
+}
+
+void checkEquivalence(unsigned seed, int initialCount = 300, int steps = 200, bool fineScores = false) {
+    std::mt19937 rng(seed);
+    StudentManager reference;
+    ConcurrentStudentManager concurrent;
+    
+    std::vector<Student> initial;
+    const int idRange = initialCount * 4 / 3;
+    for (int i = 0; i < initialCount; i++) {
+        initial.push_back(randomStudent(rng, idRange, fineScores));
+        initial.back().id = "S" + std::to_string(i);  // StudentManager 整体载入时保留重复学号，这里避开
+    }
+    reference.setStudents(initial);
+    concurrent.setStudents(initial);
+    compareState(reference, concurrent, "seed " + std::to_string(seed) + " initial");
+    
+    for (int step = 0; step < steps; step++) {
+        std::string label = "seed " + std::to_string(seed) + " step " + std::to_string(step);
+        int kind = static_cast<int>(rng() % 4);
+        if (kind == 0) {
+            Student student = randomStudent(rng, idRange, fineScores);
+            check(reference.addStudent(student).code == concurrent.addStudent(student).code, label + ": add");
+        } else if (kind == 1) {
+            std::string id = "S" + std::to_string(rng() % idRange);
+            check(reference.deleteStudent(id).code == concurrent.deleteStudent(id).code, label + ": delete");
+        } else if (kind == 2) {
+            std::string id = "S" + std::to_string(rng() % idRange);
+            Student student = randomStudent(rng, idRange, fineScores);
+            check(reference.updateStudent(id, student).code == concurrent.updateStudent(id, student).code,
+                  label + ": update");
+        } else {
+            StudentBatch batch;
+            for (int i = 0; i < 20; i++) {
+                switch (rng() % 3) {
+                    case 0: batch.add(randomStudent(rng, idRange, fineScores)); break;
+                    case 1: batch.remove("S" + std::to_string(rng() % idRange)); break;
+                    default:
+                        batch.update("S" + std::to_string(rng() % idRange), randomStudent(rng, idRange, fineScores));
+                        break;
+                }
+            }
+            bool atomic = rng() % 2;
+            BatchResult expected = reference.apply(batch, atomic);
+            BatchResult actual = concurrent.apply(batch, atomic);
+            check(expected.applied == actual.applied && expected.errors.size() == actual.errors.size(),
+                  label + ": batch");
+        }
+        compareState(reference, concurrent, label);
+    }
+}
+
+// 读者在写者不断发布新版本时取快照，检查快照内部一致：版本号不回退，学号索引与记录一致
+void checkConcurrentReaders() {
+    ConcurrentStudentManager manager;
+    std::atomic<bool> done{false};
+    std::atomic<int> readerFailures{0};
+    
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; r++) {
+        readers.emplace_back([&]() {
+            uint64_t lastVersion = 0;
+            Query query;
+            std::string error;
+            Query::parse("department = D1", query, error);
+            while (!done.load()) {
+                auto snapshot = manager.snapshot();
+                bool ok = snapshot->version() >= lastVersion;
+                lastVersion = snapshot->version();
+                size_t seen = 0;
+                snapshot->forEach([&](const Student& student) {
+                    ok = ok && snapshot->find(student.id) == &student;
+                    seen++;
+                });
+                ok = ok && seen == snapshot->size();
+                for (const Student* student : snapshot->select(query)) {
+                    ok = ok && student->department == "D1";
+                }
+                if (!ok) readerFailures++;
+            }
+        });
+    }
+    
+    std::mt19937 rng(99);
+    for (int step = 0; step < 1000; step++) {
+        if (rng() % 3 == 0) {
+            manager.deleteStudent("S" + std::to_string(rng() % 500));
+        } else {
+            manager.addStudent(randomStudent(rng, 500));
+        }
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    check(readerFailures.load() == 0, "concurrent readers saw an inconsistent snapshot");
+}
+
+} // namespace
+
+int main() {
+    for (unsigned seed = 1; seed <= 5; seed++) {
+        checkEquivalence(seed);
+    }
+    checkEquivalence(6, 1200, 200, true);
+    checkConcurrentReaders();
+    
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "Concurrent manager: all checks passed\n";
+    return 0;
+}
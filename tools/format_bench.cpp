@@ -0,0 +1,145 @@
+// 文本格式基准：比较 appendTo / parse 快速路径与原有 ostringstream / stod 实现的吞吐量
+//   sms_format_bench --records 1000000
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "student.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string referenceFormat(const Student& s) {
+    std::ostringstream oss;
+    oss << s.id << "|" << s.name << "|" << s.gender << "|" << s.age << "|"
+        << s.department << "|" << s.major << "|" << s.className << "|"
+        << std::fixed << std::setprecision(2)
+        << s.math << "|" << s.cpp << "|" << s.english << "|"
+        << s.linearAlgebra << "|" << s.political << "|"
+        << s.totalScore << "|" << s.averageScore << "|" << s.rank;
+    return oss.str();
+}
+
+Student referenceParse(const std::string& line) {
+    std::vector<std::string> tokens;
+    std::istringstream iss(line);
+    std::string token;
+    while (std::getline(iss, token, '|')) {
+        tokens.push_back(token);
+    }
+    Student s;
+    s.id = tokens[0];
+    s.name = tokens[1];
+    s.gender = tokens[2][0];
+    s.age = std::stoi(tokens[3]);
+    s.department = tokens[4];
+    s.major = tokens[5];
+    s.className = tokens[6];
+    s.math = std::stod(tokens[7]);
+    s.cpp = std::stod(tokens[8]);
+    s.english = std::stod(tokens[9]);
+    s.linearAlgebra = std::stod(tokens[10]);
+    s.political = std::stod(tokens[11]);
+    s.totalScore = std::stod(tokens[12]);
+    s.averageScore = std::stod(tokens[13]);
+    s.rank = std::stoi(tokens[14]);
+    return s;
+}
+
+std::vector<Student> makeStudents(size_t count) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> hundredths(0, 10000);
+    std::vector<Student> students(count);
+    for (size_t i = 0; i < count; i++) {
+        Student& s = students[i];
+        s.id = std::to_string(20240000000ULL + i);
+        s.name = "Student" + std::to_string(i);
+        s.gender = i % 2 ? 'F' : 'M';
+        s.age = 18 + static_cast<int>(i % 6);
+        s.department = "Computer Science";
+        s.major = "Software Engineering";
+        s.className = "SE" + std::to_string(i % 40);
+        s.math = hundredths(rng) / 100.0;
+        s.cpp = hundredths(rng) / 100.0;
+        s.english = hundredths(rng) / 100.0;
+        s.linearAlgebra = hundredths(rng) / 100.0;
+        s.political = hundredths(rng) / 100.0;
+        s.calculateScores();
+        s.rank = static_cast<int>(i + 1);
+    }
+    return students;
+}
+
+double secondsSince(Clock::time_point begin) {
+    return std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
+void report(const char* label, size_t records, size_t bytes, double seconds) {
+    std::cout << std::left << std::setw(24) << label << std::right << std::fixed
+              << std::setprecision(3) << std::setw(9) << seconds << " s"
+              << std::setprecision(0) << std::setw(12) << records / seconds << " rec/s"
+              << std::setprecision(1) << std::setw(10) << bytes / seconds / (1 << 20) << " MiB/s\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t records = 1000000;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--records" && i + 1 < argc) {
+            records = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            std::cout << "Usage: sms_format_bench [--records N]\n"
+                      << "Measures text format/parse throughput of Student records.\n";
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+    
+    std::vector<Student> students = makeStudents(records);
+    
+    // 格式化：快速路径写入一个复用的缓冲区，对照实现逐条生成字符串
+    std::string buffer;
+    auto begin = Clock::now();
+    for (const Student& s : students) {
+        s.appendTo(buffer);
+        buffer += '\n';
+    }
+    report("format (appendTo)", records, buffer.size(), secondsSince(begin));
+    
+    size_t referenceBytes = 0;
+    begin = Clock::now();
+    for (const Student& s : students) {
+        referenceBytes += referenceFormat(s).size() + 1;
+    }
+    report("format (ostringstream)", records, referenceBytes, secondsSince(begin));
+    
+    // 解析：按行切分后逐条解析到复用的对象
+    std::vector<std::string> lines;
+    lines.reserve(records);
+    for (const Student& s : students) {
+        lines.push_back(s.toString());
+    }
+    
+    Student parsed;
+    size_t checksum = 0;
+    begin = Clock::now();
+    for (const std::string& line : lines) {
+        if (Student::parse(line, parsed)) checksum += parsed.rank;
+    }
+    report("parse (from_chars)", records, buffer.size(), secondsSince(begin));
+    
+    begin = Clock::now();
+    for (const std::string& line : lines) {
+        checksum -= referenceParse(line).rank;
+    }
+    report("parse (stod)", records, buffer.size(), secondsSince(begin));
+    
+    // 防止编译器优化掉解析结果；两种实现得到的名次之和应相同
+    return checksum == 0 ? 0 : 1;
+}
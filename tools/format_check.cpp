@@ -0,0 +1,217 @@
+// 文本格式自检：Student::appendTo / Student::parse 与原有 ostringstream / stod 实现逐字节对照，
+// 并检查 格式化 -> 解析 -> 再格式化 的往返结果（含边界值）；全部通过时返回 0
+//   sms_format_check
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "student.hpp"
+
+namespace {
+
+int failures = 0;
+
+void fail(const std::string& what, const std::string& detail) {
+    if (++failures <= 20) {
+        std::cerr << "FAIL " << what << ": " << detail << "\n";
+    }
+}
+
+// 改写前的 toString，作为对照
+std::string referenceFormat(const Student& s) {
+    std::ostringstream oss;
+    oss << s.id << "|" << s.name << "|" << s.gender << "|" << s.age << "|"
+        << s.department << "|" << s.major << "|" << s.className << "|"
+        << std::fixed << std::setprecision(2)
+        << s.math << "|" << s.cpp << "|" << s.english << "|"
+        << s.linearAlgebra << "|" << s.political << "|"
+        << s.totalScore << "|" << s.averageScore << "|" << s.rank;
+    return oss.str();
+}
+
+// 改写前的 fromString（只针对合法行）
+Student referenceParse(const std::string& line) {
+    std::vector<std::string> tokens;
+    std::istringstream iss(line);
+    std::string token;
+    while (std::getline(iss, token, '|')) {
+        tokens.push_back(token);
+    }
+    Student s;
+    s.id = tokens[0];
+    s.name = tokens[1];
+    s.gender = tokens[2][0];
+    s.age = std::stoi(tokens[3]);
+    s.department = tokens[4];
+    s.major = tokens[5];
+    s.className = tokens[6];
+    s.math = std::stod(tokens[7]);
+    s.cpp = std::stod(tokens[8]);
+    s.english = std::stod(tokens[9]);
+    s.linearAlgebra = std::stod(tokens[10]);
+    s.political = std::stod(tokens[11]);
+    s.totalScore = std::stod(tokens[12]);
+    s.averageScore = std::stod(tokens[13]);
+    s.rank = std::stoi(tokens[14]);
+    return s;
+}
+
+// 按位比较，-0.0 与 0.0 视为不同
+bool sameDouble(double a, double b) {
+    return a == b && std::signbit(a) == std::signbit(b);
+}
+
+bool sameStudent(const Student& a, const Student& b) {
+    return a.id == b.id && a.name == b.name && a.gender == b.gender && a.age == b.age
+        && a.department == b.department && a.major == b.major && a.className == b.className
+        && sameDouble(a.math, b.math) && sameDouble(a.cpp, b.cpp) && sameDouble(a.english, b.english)
+        && sameDouble(a.linearAlgebra, b.linearAlgebra) && sameDouble(a.political, b.political)
+        && sameDouble(a.totalScore, b.totalScore) && sameDouble(a.averageScore, b.averageScore)
+        && a.rank == b.rank;
+}
+
+// 格式化与原实现一致；解析结果与原实现一致；解析后再格式化得到同一行
+void checkRoundTrip(const Student& student) {
+    std::string line;
+    student.appendTo(line);
+    std::string expected = referenceFormat(student);
+    if (line != expected) {
+        fail("format", "got \"" + line + "\", expected \"" + expected + "\"");
+        return;
+    }
+    
+    Student parsed;
+    const char* error = nullptr;
+    if (!Student::parse(line, parsed, &error)) {
+        fail("parse", "\"" + line + "\": " + error);
+        return;
+    }
+    if (!sameStudent(parsed, referenceParse(line))) {
+        fail("parse", "\"" + line + "\" differs from the stod/stoi result");
+    }
+    
+    std::string again;
+    parsed.appendTo(again);
+    if (again != line) {
+        fail("round trip", "\"" + line + "\" -> \"" + again + "\"");
+    }
+}
+
+Student makeStudent(const std::string& id, const std::string& name, char gender, int age,
+                    double math, double cpp, double english, double linearAlgebra, double political,
+                    int rank) {
+    Student s(id, name, gender, age);
+    s.department = "Computer";
+    s.major = "CS";
+    s.className = "CS01";
+    s.math = math;
+    s.cpp = cpp;
+    s.english = english;
+    s.linearAlgebra = linearAlgebra;
+    s.political = political;
+    s.calculateScores();
+    s.rank = rank;
+    return s;
+}
+
+void checkEdgeValues() {
+    const double max = std::numeric_limits<double>::max();
+    const double tiny = std::numeric_limits<double>::denorm_min();
+    checkRoundTrip(makeStudent("2024001", "Zhang San", 'M', 18, 0, 0, 0, 0, 0, 1));
+    checkRoundTrip(makeStudent("2024002", "Li Si", 'F', 22, 100, 100, 100, 100, 100, 1));
+    checkRoundTrip(makeStudent("2024003", "Wang Wu", 'M', 19, 99.99, 0.01, 59.995, 60.005, 0.005, 3));
+    checkRoundTrip(makeStudent("2024004", "Zhao Liu", 'F', 20, 85.333333, 2.0 / 3, 1e-9, 99.999999, 12.345, 42));
+    checkRoundTrip(makeStudent("2024005", "Neg", 'M', -1, -0.0, -0.004, -12.5, -100, 0, -7));
+    checkRoundTrip(makeStudent("2024006", "Huge", 'M', std::numeric_limits<int>::max(),
+                               1e20, 123456789.125, max, tiny, 0, std::numeric_limits<int>::min()));
+    checkRoundTrip(makeStudent(std::string(200, '9'), std::string(1000, 'x'), 'F', 0, 1, 2, 3, 4, 5, 0));
+    
+    // 空字段：姓名、院系等为空，性别为空时解析为 '\0'
+    Student empty = makeStudent("", "", '\0', 18, 0, 0, 0, 0, 0, 0);
+    empty.department.clear();
+    empty.major.clear();
+    empty.className.clear();
+    checkRoundTrip(empty);
+    
+    // UTF-8 文本原样保留
+    Student chinese = makeStudent("2024007", "张三", 'M', 18, 88.5, 92, 76.25, 81, 90, 5);
+    chinese.department = "计算机学院";
+    chinese.major = "软件工程";
+    chinese.className = "软工2401";
+    checkRoundTrip(chinese);
+}
+
+void checkRandom(size_t count) {
+    std::mt19937_64 rng(20240401);
+    std::uniform_int_distribution<int> hundredths(0, 10000);
+    std::uniform_real_distribution<double> any(-1000, 1000);
+    for (size_t i = 0; i < count; i++) {
+        Student s;
+        s.id = std::to_string(rng());
+        s.name = "Student" + std::to_string(i);
+        s.gender = i % 2 ? 'F' : 'M';
+        s.age = static_cast<int>(rng() % 60);
+        s.department = "Dept" + std::to_string(i % 7);
+        s.major = "Major" + std::to_string(i % 13);
+        s.className = "Class" + std::to_string(i % 29);
+        // 一半是两位小数成绩，一半是任意值（检验四舍五入与原实现一致）
+        bool gridded = i % 2 == 0;
+        double* fields[] = {&s.math, &s.cpp, &s.english, &s.linearAlgebra, &s.political};
+        for (double* field : fields) {
+            *field = gridded ? hundredths(rng) / 100.0 : any(rng);
+        }
+        s.calculateScores();
+        s.rank = static_cast<int>(rng() % 100000);
+        checkRoundTrip(s);
+    }
+}
+
+// 手写的行：与 stod/stoi 一样接受前导空白、'+' 号和尾部多余字符，多余字段忽略
+void checkLenientInput() {
+    const char* lines[] = {
+        "S1|Name|M| 18|D|M|C| 85.5|+90|90.00abc|70|60|395.5|79.1|2",
+        "S2|Name|F|20|D|M|C|1e2|0.5e1|.25|0|0|105.25|21.05|7|extra|fields",
+        "S3|Name|M|18|D|M|C|\t42|42|42|42|42|210|42|1",
+    };
+    for (const char* text : lines) {
+        Student parsed;
+        if (!Student::parse(text, parsed)) {
+            fail("lenient parse", text);
+        } else if (!sameStudent(parsed, referenceParse(text))) {
+            fail("lenient parse", std::string(text) + " differs from the stod/stoi result");
+        }
+    }
+    
+    const char* invalid[] = {
+        "",
+        "S1|Name|M|18|D|M|C|85|90|90|70|60|395|79",        // 只有 14 个字段
+        "S1|Name|M|abc|D|M|C|85|90|90|70|60|395|79|1",     // 年龄不是数字
+        "S1|Name|M|18|D|M|C|85|90|x|70|60|395|79|1",       // 成绩不是数字
+    };
+    for (const char* text : invalid) {
+        Student parsed;
+        const char* error = nullptr;
+        if (Student::parse(text, parsed, &error) || !error) {
+            fail("reject", std::string("\"") + text + "\" was accepted");
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    checkEdgeValues();
+    checkRandom(20000);
+    checkLenientInput();
+    
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "Text format round trip: all checks passed\n";
+    return 0;
+}
@@ -0,0 +1,155 @@
+// 预写日志自检：模拟 保存快照 -> 重启 -> 修改 -> 重启 的过程，检查每次重启后
+// 快照加日志重放得到的数据与重启前一致；文本和二进制数据文件各跑一遍，全部通过时返回 0
+//   sms_journal_check
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include "journal.hpp"
+#include "storage.hpp"
+#include "student.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        failures++;
+        std::cerr << "FAIL " << what << "\n";
+    }
+}
+
+// 一次进程运行：与 main.cpp 的 loadData 相同，载入快照、从快照序号接续打开日志并重放
+struct Session {
+    FileStorage storage;
+    Journal journal;
+    StudentManager manager;
+    
+    explicit Session(const std::string& dataFile) {
+        storage.setDataFile(dataFile);
+        manager.setStudents(storage.loadStudents());
+        if (journal.open(dataFile + ".journal", storage.getSnapshotSequence())) {
+            journal.replay(manager, storage.getSnapshotSequence());
+            manager.setJournal(&journal);
+            storage.setJournal(&journal);
+        }
+    }
+    
+    bool save() { return storage.saveStudents(manager.view()); }
+};
+
+Student makeStudent(const std::string& id, double score) {
+    Student student(id, "Student " + id, 'F', 19);
+    student.department = "Computer";
+    student.major = "CS";
+    student.className = "CS01";
+    student.math = student.cpp = student.english = student.linearAlgebra = student.political = score;
+    student.calculateScores();
+    return student;
+}
+
+// 期望的数据：学号 -> 平均分
+using Expected = std::map<std::string, double>;
+
+void expectContents(Session& session, const Expected& expected, const std::string& step) {
+    check(session.manager.getCount() == expected.size(),
+          step + ": expected " + std::to_string(expected.size()) + " records, found "
+          + std::to_string(session.manager.getCount()));
+    for (const auto& entry : expected) {
+        const Student* student = session.manager.findStudent(entry.first);
+        check(student && student->averageScore == entry.second, step + ": record " + entry.first);
+    }
+}
+
+void runScenario(const fs::path& directory, const std::string& fileName) {
+    const std::string dataFile = (directory / fileName).string();
+    const std::string label = fileName + ": ";
+    Expected expected;
+    auto restart = [&](std::unique_ptr<Session>& session) {
+        session.reset();  // 析构时关闭日志，相当于进程退出
+        session.reset(new Session(dataFile));
+    };
+    
+    std::unique_ptr<Session> session(new Session(dataFile));
+    session->manager.addStudent(makeStudent("S1", 60));
+    session->manager.addStudent(makeStudent("S2", 70));
+    expected = {{"S1", 60}, {"S2", 70}};
+    check(session->save(), label + "first snapshot");
+    
+    // 快照截断日志后重启，再修改：新记录的序号必须接在快照之后
+    restart(session);
+    expectContents(*session, expected, label + "after snapshot restart");
+    session->manager.addStudent(makeStudent("S3", 80));
+    session->manager.updateStudent("S1", makeStudent("S1", 65));
+    session->manager.deleteStudent("S2");
+    expected = {{"S1", 65}, {"S3", 80}};
+    
+    restart(session);
+    expectContents(*session, expected, label + "after mutate restart");
+    
+    // 未保存快照的多次重启：日志持续追加，序号继续递增
+    session->manager.addStudent(makeStudent("S4", 90));
+    expected["S4"] = 90;
+    restart(session);
+    expectContents(*session, expected, label + "after second journal-only restart");
+    
+    // 再次保存快照后重启修改
+    check(session->save(), label + "second snapshot");
+    restart(session);
+    session->manager.deleteStudent("S3");
+    expected.erase("S3");
+    restart(session);
+    expectContents(*session, expected, label + "after second snapshot restart");
+    
+    // 进程崩溃（不经析构、未 fsync）：已返回的修改都已写入操作系统，拷贝当时的文件即可重放
+    session->manager.addStudent(makeStudent("S6", 75));
+    expected["S6"] = 75;
+    {
+        const fs::path crashed = directory / "crashed";
+        fs::create_directories(crashed);
+        fs::copy_file(dataFile, crashed / fileName, fs::copy_options::overwrite_existing);
+        fs::copy_file(dataFile + ".journal", crashed / (fileName + ".journal"), fs::copy_options::overwrite_existing);
+        Session recovered((crashed / fileName).string());
+        expectContents(recovered, expected, label + "after crash without sync");
+    }
+    
+    // 崩溃留下半条记录：重启后截掉残缺尾部，之后的修改仍能重放
+    session.reset();
+    {
+        std::ofstream journalFile(dataFile + ".journal", std::ios::app | std::ios::binary);
+        journalFile << "deadbeef 99|A|torn";
+    }
+    session.reset(new Session(dataFile));
+    expectContents(*session, expected, label + "after torn tail");
+    session->manager.addStudent(makeStudent("S5", 55));
+    expected["S5"] = 55;
+    restart(session);
+    expectContents(*session, expected, label + "after torn tail restart");
+}
+
+} // namespace
+
+int main() {
+    fs::path directory = fs::temp_directory_path()
+        / ("sms_journal_check_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(directory);
+    
+    runScenario(directory, "students.txt");
+    runScenario(directory, "students.bin");
+    
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+    
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "Journal replay across restarts: all checks passed\n";
+    return 0;
+}
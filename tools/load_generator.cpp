@@ -0,0 +1,185 @@
+// 查询服务的本地压测工具：多条 keep-alive 连接并发发送 GET 请求，统计吞吐量与延迟分位数
+//   sms_loadgen --port 8080 --connections 8 --requests 20000 --path "/top?k=10" --path /stats
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    uint16_t port = 8080;
+    size_t connections = 8;
+    size_t requests = 10000;
+    std::vector<std::string> paths;
+};
+
+struct WorkerResult {
+    std::vector<double> latencies;  // 微秒
+    size_t failures = 0;            // 非 2xx 响应
+    bool broken = false;            // 连接失败或被关闭
+};
+
+int connectTo(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    return fd;
+}
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t count = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (count <= 0) return false;
+        sent += count;
+    }
+    return true;
+}
+
+// 读取一个完整响应，返回状态码；buffer 保留多读的字节
+int readResponse(int fd, std::string& buffer) {
+    char chunk[16 << 10];
+    size_t headerEnd;
+    while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+        ssize_t count = recv(fd, chunk, sizeof(chunk), 0);
+        if (count <= 0) return -1;
+        buffer.append(chunk, count);
+    }
+
+    int status = std::atoi(buffer.c_str() + buffer.find(' ') + 1);
+    size_t contentLength = 0;
+    size_t header = buffer.find("Content-Length:");
+    if (header != std::string::npos && header < headerEnd) {
+        contentLength = std::strtoull(buffer.c_str() + header + 15, nullptr, 10);
+    }
+    size_t total = headerEnd + 4 + contentLength;
+    while (buffer.size() < total) {
+        ssize_t count = recv(fd, chunk, sizeof(chunk), 0);
+        if (count <= 0) return -1;
+        buffer.append(chunk, count);
+    }
+    buffer.erase(0, total);
+    return status;
+}
+
+void runWorker(const Options& options, size_t index, size_t count, WorkerResult& result) {
+    int fd = connectTo(options.port);
+    if (fd < 0) {
+        result.broken = true;
+        return;
+    }
+    result.latencies.reserve(count);
+    std::string buffer;
+    for (size_t i = 0; i < count; i++) {
+        const std::string& path = options.paths[(index + i) % options.paths.size()];
+        std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+
+        auto begin = Clock::now();
+        if (!sendAll(fd, request)) {
+            result.broken = true;
+            break;
+        }
+        int status = readResponse(fd, buffer);
+        if (status < 0) {
+            result.broken = true;
+            break;
+        }
+        result.latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - begin).count());
+        if (status < 200 || status >= 300) result.failures++;
+    }
+    close(fd);
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t rank = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+void printUsage() {
+    std::cout << "Usage: sms_loadgen [--port N] [--connections N] [--requests N] [--path P]...\n"
+              << "Sends GET requests over keep-alive connections to the local query server\n"
+              << "(StudentManagementSystem --serve N) and reports throughput and latency.\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--port" && hasValue) {
+            options.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        } else if (arg == "--connections" && hasValue) {
+            options.connections = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--requests" && hasValue) {
+            options.requests = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--path" && hasValue) {
+            options.paths.push_back(argv[++i]);
+        } else {
+            printUsage();
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+    if (options.paths.empty()) {
+        options.paths = {"/top?k=10", "/stats", "/search?field=major&value=CS&limit=20"};
+    }
+
+    std::vector<WorkerResult> results(options.connections);
+    std::vector<std::thread> threads;
+    auto begin = Clock::now();
+    for (size_t i = 0; i < options.connections; i++) {
+        size_t count = options.requests / options.connections + (i < options.requests % options.connections ? 1 : 0);
+        threads.emplace_back(runWorker, std::cref(options), i, count, std::ref(results[i]));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    std::vector<double> latencies;
+    size_t failures = 0, broken = 0;
+    for (const auto& result : results) {
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        failures += result.failures;
+        broken += result.broken ? 1 : 0;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Requests:    " << latencies.size() << " (" << failures << " non-2xx, "
+              << broken << " broken connections)\n";
+    std::cout << "Elapsed:     " << seconds << " s\n";
+    std::cout << "Throughput:  " << (seconds > 0 ? latencies.size() / seconds : 0) << " req/s\n";
+    std::cout << std::setprecision(3);
+    std::cout << "Latency ms:  p50 " << percentile(latencies, 0.50) / 1000
+              << "  p90 " << percentile(latencies, 0.90) / 1000
+              << "  p99 " << percentile(latencies, 0.99) / 1000
+              << "  max " << (latencies.empty() ? 0 : latencies.back() / 1000) << "\n";
+    return broken > 0 || latencies.size() < options.requests ? 1 : 0;
+}